@@ -1,4 +1,5 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 #include <pybind11/numpy.h>
@@ -7,6 +8,10 @@
 
 #include <morphio/types.h>
 #include <morphio/enums.h>
+#include <morphio/archive.h>
+#include <morphio/collection.h>
+#include <morphio/container.h>
+#include <morphio/prefetcher.h>
 #include <morphio/mut/morphology.h>
 
 #include "bind_enums.h"
@@ -20,9 +25,16 @@ static void bind_immutable_module(py::module &m) {
     py::add_ostream_redirect(m, "ostream_redirect");
 
     py::class_<morphio::Morphology>(m, "Morphology")
-        .def(py::init<const morphio::URI&, unsigned int>(),
-             "filename"_a, "options"_a=morphio::enums::Option::NO_MODIFIER)
+        .def(py::init<const morphio::URI&, unsigned int, const std::set<morphio::SectionType>&>(),
+             "filename"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "section_types"_a=std::set<morphio::SectionType>())
+        .def(py::init<const std::string&, const std::string&, unsigned int, const std::set<morphio::SectionType>&>(),
+             "contents"_a, "extension"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "section_types"_a=std::set<morphio::SectionType>())
         .def(py::init<morphio::mut::Morphology&>())
+        .def(py::init<const morphio::Container&, const std::string&, unsigned int, const std::set<morphio::SectionType>&>(),
+             "container"_a, "name"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "section_types"_a=std::set<morphio::SectionType>())
 
         .def("as_mutable", [](const morphio::Morphology* morph) { return morphio::mut::Morphology(*morph); })
 
@@ -53,6 +65,11 @@ static void bind_immutable_module(py::module &m) {
                 return py::array(static_cast<py::ssize_t>(morpho->points().size()), morpho->points().data());
             },
             "Returns a list with all points from all sections")
+        .def_property_readonly("point_columns", [](morphio::Morphology* morpho){
+                const auto& columns = morpho->pointColumns();
+                return columns_to_ndarray({columns.x(), columns.y(), columns.z()});
+            },
+            "Returns the x, y and z coordinates of points as the rows of a (3, N) array")
         .def_property_readonly("diameters", [](morphio::Morphology* morpho){
                 auto diameters = morpho->diameters();
                 return py::array(static_cast<py::ssize_t>(diameters.size()), diameters.data());
@@ -158,6 +175,8 @@ static void bind_immutable_module(py::module &m) {
                                "(dendrite, axon, ...)")
         .def_property_readonly("points", [](morphio::Section* section){ return span_array_to_ndarray(section->points()); },
                                "Returns list of section's point coordinates")
+        .def_property_readonly("point_columns", [](morphio::Section* section){ return columns_to_ndarray(section->pointColumns()); },
+                               "Returns the x, y and z coordinates of the section's points as the rows of a (3, N) array")
         .def_property_readonly("diameters", [](morphio::Section* section){ return span_to_ndarray(section->diameters()); },
                                "Returns list of section's point diameters")
         .def_property_readonly("perimeters", [](morphio::Section* section){ return span_to_ndarray(section->perimeters()); },
@@ -233,4 +252,111 @@ static void bind_immutable_module(py::module &m) {
             "at each root section",
             "iter_type"_a=IterType::DEPTH_FIRST);
 
+    py::class_<morphio::LoadResult>(m, "LoadResult")
+        .def_readonly("index", &morphio::LoadResult::index,
+                      "Returns the position of the file in the collection")
+        .def_readonly("uri", &morphio::LoadResult::uri,
+                      "Returns the path of the file")
+        .def_property_readonly("morphology", [](const morphio::LoadResult& result) {
+                return result.morphology.get();
+            },
+            py::return_value_policy::reference_internal,
+            "Returns the loaded morphology (None if the loading failed)")
+        .def_readonly("error", &morphio::LoadResult::error,
+                      "Returns the error message (empty if the loading succeeded)");
+
+    py::class_<morphio::Collection>(m, "Collection")
+        .def(py::init<const std::vector<morphio::URI>&, unsigned int, unsigned int, size_t>(),
+             "filenames"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "n_threads"_a=0, "max_in_flight"_a=0)
+        .def_static("from_directory", &morphio::Collection::fromDirectory,
+                    "Create a collection from all the morphology files of a directory",
+                    "directory"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+                    "n_threads"_a=0, "max_in_flight"_a=0)
+        .def("load", static_cast<std::vector<morphio::LoadResult> (morphio::Collection::*)() const>(
+                 &morphio::Collection::load),
+             py::call_guard<py::gil_scoped_release>(),
+             "Load all files in parallel and return the results in input order")
+        .def("load", static_cast<void (morphio::Collection::*)(const morphio::Collection::Callback&, bool) const>(
+                 &morphio::Collection::load),
+             py::call_guard<py::gil_scoped_release>(),
+             "Load all files in parallel and call the callback with each result\n"
+             "as soon as it is loaded, or in input order if ordered is True",
+             "callback"_a, "ordered"_a=false)
+        .def_property_readonly("uris", &morphio::Collection::uris,
+                               "Returns the list of files")
+        .def_property_readonly("n_threads", &morphio::Collection::threads,
+                               "Returns the number of loading threads")
+        .def_property_readonly("max_in_flight", &morphio::Collection::maxInFlight,
+                               "Returns the maximum number of loaded morphologies "
+                               "not yet handed to the callback")
+        .def("__len__", &morphio::Collection::size);
+
+    py::class_<morphio::Archive>(m, "Archive",
+        "An uncompressed tar archive of morphology files, read in place without extraction")
+        .def(py::init<const morphio::URI&>(), "filename"_a)
+        .def_property_readonly("names", &morphio::Archive::names,
+                               "Returns the names of the files of the archive, in archive order")
+        .def("morphology", &morphio::Archive::morphology,
+             py::call_guard<py::gil_scoped_release>(),
+             "Parse the morphology stored in the archive under the given name",
+             "name"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "section_types"_a=std::set<morphio::SectionType>())
+        .def("__contains__", &morphio::Archive::contains)
+        .def("__len__", &morphio::Archive::size);
+
+    py::class_<morphio::Container>(m, "Container",
+        "An HDF5 file holding many morphologies, kept open to read them one by one\n\n"
+        "Use Morphology(container, name) to load one of them")
+        .def(py::init<const morphio::URI&>(), "filename"_a)
+        .def_property_readonly("names", &morphio::Container::names,
+                               "Returns the names of the morphologies, in storage order")
+        .def("__contains__", &morphio::Container::contains)
+        .def("__len__", &morphio::Container::size);
+
+    py::class_<std::shared_future<morphio::Morphology>>(m, "MorphologyFuture",
+        "A morphology being loaded in the background, returned by load_async")
+        .def("result", [](const std::shared_future<morphio::Morphology>& future) {
+                return future.get();
+            },
+            py::call_guard<py::gil_scoped_release>(),
+            "Wait for the morphology and return it, or raise the error of its loading")
+        .def("done", [](const std::shared_future<morphio::Morphology>& future) {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            },
+            "Returns True if the loading is over");
+
+    m.def("load_async", [](const morphio::URI& uri, unsigned int options,
+                           const std::set<morphio::SectionType>& sectionTypes) {
+              return morphio::loadAsync(uri, options, sectionTypes).share();
+          },
+          "Start loading a morphology on a new thread and return a MorphologyFuture",
+          "filename"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+          "section_types"_a=std::set<morphio::SectionType>());
+
+    py::class_<morphio::Prefetcher>(m, "Prefetcher",
+        "Load a list of files in the background, at most depth files ahead of the consumer.\n"
+        "Iterating yields a LoadResult per file, in input order.")
+        .def(py::init<const std::vector<morphio::URI>&, unsigned int, size_t, unsigned int>(),
+             "filenames"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "depth"_a=0, "n_threads"_a=1)
+        .def("__iter__", [](morphio::Prefetcher& prefetcher) -> morphio::Prefetcher& {
+                return prefetcher;
+            })
+        .def("__next__", [](morphio::Prefetcher& prefetcher) {
+                morphio::LoadResult result;
+                bool found;
+                {
+                    py::gil_scoped_release release;
+                    found = prefetcher.next(result);
+                }
+                if (!found)
+                    throw py::stop_iteration();
+                return result;
+            })
+        .def("cancel", &morphio::Prefetcher::cancel,
+             "Stop loading, the iteration stops")
+        .def_property_readonly("depth", &morphio::Prefetcher::depth,
+                               "Returns the maximum number of files loaded ahead of the consumer")
+        .def("__len__", &morphio::Prefetcher::size);
 }
@@ -5,6 +5,7 @@
 #include <pybind11/iostream.h>
 #include <pybind11/operators.h>
 
+#include <morphio/cache.h>
 #include <morphio/types.h>
 #include <morphio/enums.h>
 #include <morphio/tools.h>
@@ -26,6 +27,26 @@ static void bind_misc(py::module &m) {
     m.def("set_ignored_warning", static_cast<void (*)(const std::vector<morphio::Warning>&, bool)>(&morphio::set_ignored_warning),
           "Ignore/Unignore a list of warnings", "warning"_a, "ignore"_a = true);
 
+    py::class_<morphio::CacheStatistics>(m, "CacheStatistics")
+        .def_readonly("hits", &morphio::CacheStatistics::hits)
+        .def_readonly("misses", &morphio::CacheStatistics::misses)
+        .def_readonly("evictions", &morphio::CacheStatistics::evictions)
+        .def_readonly("entries", &morphio::CacheStatistics::entries)
+        .def_readonly("bytes", &morphio::CacheStatistics::bytes);
+
+    m.def("set_cache_capacity", &morphio::set_cache_capacity,
+          "Set the memory budget (in bytes) of the cache of loaded morphologies\n"
+          "0 (the default) disables the cache",
+          "bytes"_a);
+    m.def("cache_capacity", &morphio::cache_capacity,
+          "Returns the memory budget (in bytes) of the cache of loaded morphologies");
+    m.def("cache_statistics", &morphio::cache_statistics,
+          "Returns the hit, miss and eviction counters and the size of the cache");
+    m.def("invalidate_cache", &morphio::invalidate_cache,
+          "Remove all the entries of the given file from the cache", "filename"_a);
+    m.def("clear_cache", &morphio::clear_cache,
+          "Remove all the entries from the cache and reset the counters");
+
     py::enum_<morphio::enums::AnnotationType>(m, "AnnotationType")
         .value("single_child", morphio::enums::AnnotationType::SINGLE_CHILD,
             "Indicates that a section has only one child");
@@ -69,6 +90,8 @@ static void bind_misc(py::module &m) {
         .value("soma_sphere", morphio::enums::Option::SOMA_SPHERE)
         .value("no_duplicates", morphio::enums::Option::NO_DUPLICATES)
         .value("nrn_order", morphio::enums::Option::NRN_ORDER)
+        .value("lazy_load", morphio::enums::Option::LAZY_LOAD)
+        .value("lazy_load_sections", morphio::enums::Option::LAZY_LOAD_SECTIONS)
         .export_values();
 
 
@@ -182,9 +205,20 @@ static void bind_misc(py::module &m) {
                        "Returns a list of [offset, parent section ID]")
         .def_readwrite("section_types", &morphio::Property::SectionLevel::_sectionTypes,
                        "Returns the list of section types")
-        .def_readwrite("children", &morphio::Property::SectionLevel::_children,
-                       "Returns a dictionary where key is a section ID "
-                       "and value is the list of children section IDs");
+        .def_property_readonly("children", [](const morphio::Property::SectionLevel& level) {
+                const auto& children = level._children;
+                std::map<int32_t, std::vector<uint32_t>> result;
+                if (!children._roots.empty())
+                    result[-1] = children._roots;
+                for (size_t id = 0; id + 1 < children._offsets.size(); ++id) {
+                    const auto ids = children.children(static_cast<uint32_t>(id));
+                    if (!ids.empty())
+                        result[static_cast<int32_t>(id)] = std::vector<uint32_t>(ids.begin(), ids.end());
+                }
+                return result;
+            },
+            "Returns a dictionary where key is a section ID "
+            "and value is the list of children section IDs");
 
     py::class_<morphio::Property::CellLevel>(m, "CellLevel",
                                              "Container class for information available at the cell level (cell type, file version, soma type)")
@@ -2,6 +2,7 @@
 #include <morphio/mut/morphology.h>
 #include <morphio/mut/section.h>
 #include <morphio/mut/soma.h>
+#include <morphio/mut/writers.h>
 
 #include "bind_enums.h"
 
@@ -10,10 +11,24 @@ namespace py = pybind11;
 static void bind_mutable_module(py::module &m) {
     using namespace py::literals;
 
+    py::class_<morphio::mut::writer::H5Options>(m, "H5Options",
+        "Storage options of the HDF5 datasets written by Morphology.write and ContainerWriter")
+        .def(py::init<>())
+        .def_readwrite("chunk_size", &morphio::mut::writer::H5Options::chunkSize,
+                       "Number of rows of a chunk of the datasets")
+        .def_readwrite("deflate_level", &morphio::mut::writer::H5Options::deflateLevel,
+                       "Compression level of the deflate filter, from 0 (no compression) to 9")
+        .def_readwrite("shuffle", &morphio::mut::writer::H5Options::shuffle,
+                       "Whether the bytes are shuffled before the compression");
+
     auto mutable_morphology = py::class_<morphio::mut::Morphology>(m, "Morphology")
         .def(py::init<>())
-        .def(py::init<const morphio::URI&, unsigned int>(),
-             "filename"_a, "options"_a=morphio::enums::Option::NO_MODIFIER)
+        .def(py::init<const morphio::URI&, unsigned int, const std::set<morphio::SectionType>&>(),
+             "filename"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "section_types"_a=std::set<morphio::SectionType>())
+        .def(py::init<const std::string&, const std::string&, unsigned int, const std::set<morphio::SectionType>&>(),
+             "contents"_a, "extension"_a, "options"_a=morphio::enums::Option::NO_MODIFIER,
+             "section_types"_a=std::set<morphio::SectionType>())
         .def(py::init<const morphio::Morphology&, unsigned int>(),
              "morphology"_a, "options"_a=morphio::enums::Option::NO_MODIFIER)
         .def(py::init<const morphio::mut::Morphology&, unsigned int>(),
@@ -59,7 +74,7 @@ static void bind_mutable_module(py::module &m) {
 
         .def("as_immutable", [](const morphio::mut::Morphology* morph) { return morphio::Morphology(*morph); })
 
-        .def_property_readonly("cell_family", &morphio::mut::Morphology::cellFamily,
+        .def_property_readonly("cell_family", static_cast<morphio::CellFamily& (morphio::mut::Morphology::*) ()>(&morphio::mut::Morphology::cellFamily),
                                "Returns the cell family (neuron or glia)")
 
         .def_property_readonly("soma_type", &morphio::mut::Morphology::somaType,
@@ -68,8 +83,10 @@ static void bind_mutable_module(py::module &m) {
         .def_property_readonly("version", &morphio::mut::Morphology::version,
                                "Returns the version")
 
-        .def("write", &morphio::mut::Morphology::write,
-             "Write file to H5, SWC, ASC format depending on filename extension", "filename"_a)
+        .def("write", static_cast<void (morphio::mut::Morphology::*) (const std::string&, const morphio::mut::writer::H5Options&)>(&morphio::mut::Morphology::write),
+             "Write file to H5, SWC, ASC format depending on filename extension\n\n"
+             "options sets the chunking and compression of the H5 datasets",
+             "filename"_a, "options"_a=morphio::mut::writer::H5Options())
 
         // Iterators
         .def("iter", [](morphio::mut::Morphology* morph, IterType type) {
@@ -339,4 +356,28 @@ static void bind_mutable_module(py::module &m) {
                 return py::array(3, soma->center().data());
             },
             "Returns the center of gravity of the soma points");
+
+    py::class_<morphio::mut::writer::ContainerWriter>(m, "ContainerWriter",
+        "Write many morphologies in one HDF5 container, read back with morphio.Container\n\n"
+        "Each add() writes the cell and its index entry, the container can be read "
+        "up to the last cell added. With append=True, an existing container is extended.\n\n"
+        "add() can be called from several threads, the morphologies are appended one at a time")
+        .def(py::init<const std::string&, const morphio::mut::writer::H5Options&, bool>(),
+             "filename"_a, "options"_a=morphio::mut::writer::H5Options(), "append"_a=false)
+        .def("add", static_cast<void (morphio::mut::writer::ContainerWriter::*) (const std::string&, const morphio::mut::Morphology&)>(&morphio::mut::writer::ContainerWriter::add),
+             py::call_guard<py::gil_scoped_release>(),
+             "Append a morphology to the container under the given name",
+             "name"_a, "morphology"_a)
+        .def("add", static_cast<void (morphio::mut::writer::ContainerWriter::*) (const std::string&, const morphio::Morphology&)>(&morphio::mut::writer::ContainerWriter::add),
+             py::call_guard<py::gil_scoped_release>(),
+             "Append a morphology to the container under the given name",
+             "name"_a, "morphology"_a)
+        .def("close", &morphio::mut::writer::ContainerWriter::close,
+             py::call_guard<py::gil_scoped_release>(),
+             "Write the index of the container and close the file")
+        .def("__enter__", [](morphio::mut::writer::ContainerWriter* writer) { return writer; },
+             py::return_value_policy::reference)
+        .def("__exit__", [](morphio::mut::writer::ContainerWriter* writer, py::object, py::object, py::object) {
+                writer->close();
+            });
 }
@@ -19,6 +19,8 @@ static void bind_vasculature(py::module &m) {
     py::class_<morphio::vasculature::Vasculature>(m, "Vasculature")
         .def(py::init<const morphio::URI&>(),
              "filename"_a)
+        .def(py::init<const std::string&, const std::string&>(),
+             "contents"_a, "extension"_a)
         // .def(py::init<morphio::mut::Morphology&>())
         // .def("as_mutable", [](const morphio::vasculature::VasculatureMorphology* morph) { return morphio::mut::Morphology(*morph); })
 
@@ -41,6 +41,16 @@ py::array_t<float> span_to_ndarray(const morphio::range<const T>& span)
     return py::array(buffer_info);
 }
 
+// Copy the x, y and z columns in the rows of a (3, N) array
+static py::array_t<float> columns_to_ndarray(const std::array<morphio::range<const float>, 3>& columns)
+{
+    py::array_t<float> array({static_cast<py::ssize_t>(3), static_cast<py::ssize_t>(columns[0].size())});
+    for (py::ssize_t axis = 0; axis < 3; ++axis) {
+        const auto& column = columns[static_cast<size_t>(axis)];
+        std::copy(column.begin(), column.end(), array.mutable_data(axis));
+    }
+    return array;
+}
 
 static void _raise_if_wrong_shape(const py::buffer_info& info) {
     const auto &shape = info.shape;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>        // std::shared_ptr
+#include <set>           // std::set
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+namespace readers {
+class MemoryMap;
+}
+
+/**
+   An uncompressed tar archive of morphology files, read in place
+
+   The archive is memory mapped and its headers are indexed once upon
+   construction. Each morphology is then parsed directly from its bytes in
+   the mapping: the members are never extracted to disk. Member names are
+   the paths stored in the archive, without their leading "./".
+
+   Example:
+       Archive archive("morphologies.tar");
+       for (const auto& name : archive.names())
+           Morphology morphology = archive.morphology(name);
+
+   The archive is not modified by loading, a const Archive can be shared by
+   several threads.
+**/
+class Archive
+{
+public:
+    explicit Archive(const URI& uri);
+
+    /**
+       The names of all the regular files of the archive, in archive order
+    **/
+    const std::vector<std::string>& names() const;
+
+    bool contains(const std::string& name) const;
+    size_t size() const;
+
+    /**
+       Parse the member name, with the format given by its extension (see
+       Morphology). Throw a RawDataError if there is no such member.
+    **/
+    Morphology morphology(const std::string& name,
+        unsigned int options = NO_MODIFIER,
+        const std::set<SectionType>& sectionTypes = {}) const;
+
+private:
+    struct Range
+    {
+        size_t offset;
+        size_t size;
+    };
+
+    URI _uri;
+    std::shared_ptr<const readers::MemoryMap> _map;
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, Range> _members;
+};
+} // namespace morphio
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+#include <morphio/types.h>
+
+namespace morphio {
+/**
+   Counters of the process-wide cache of loaded morphologies
+**/
+struct CacheStatistics
+{
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;
+};
+
+/**
+   Set the memory budget (in bytes) of the process-wide cache of loaded
+   morphologies
+
+   When the budget is not 0, Morphology(uri, options) looks up the cache
+   before reading the file and instances created from the same file with the
+   same options share their data. Entries are keyed by canonical path,
+   options and file modification time and size, so that a modified file is
+   read again. The least recently used entries are evicted when the budget is
+   exceeded.
+
+   0 (the default) disables the cache and clears it.
+**/
+void set_cache_capacity(size_t bytes);
+size_t cache_capacity();
+
+CacheStatistics cache_statistics();
+
+/**
+   Remove all the entries of the given file from the cache
+**/
+void invalidate_cache(const URI& uri);
+
+/**
+   Remove all the entries from the cache and reset the counters
+**/
+void clear_cache();
+} // namespace morphio
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <functional> // std::function
+#include <memory>     // std::shared_ptr
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+/**
+   Outcome of the loading of one file of a Collection
+
+   On success, morphology holds the loaded morphology and error is empty.
+   On failure, morphology is null and error holds the exception message.
+**/
+struct LoadResult
+{
+    size_t index;
+    URI uri;
+    std::shared_ptr<Morphology> morphology;
+    std::string error;
+};
+
+/**
+   A list of morphology files to be loaded in parallel
+
+   Files are distributed dynamically on a pool of threads, so that a few
+   large files do not stall the others. Each thread reads the SWC, ASC and
+   MBIN files it claims in batches, asynchronously with io_uring on Linux,
+   before parsing them. A file failing to load does not abort
+   the batch: its error is reported in the corresponding LoadResult.
+
+   Example:
+       Collection collection(uris, NO_DUPLICATES, 8);
+       for (const auto& result : collection.load())
+           if (result.morphology)
+               ...
+**/
+class Collection
+{
+public:
+    using Callback = std::function<void(LoadResult&&)>;
+
+    /**
+       Create a collection from a list of files
+
+       - options: the modifier flags applied to each morphology (see Morphology)
+       - nThreads: the number of loading threads, 0 means one per hardware thread
+       - maxInFlight: the maximum number of morphologies loaded but not yet
+         handed to the callback of load(Callback, bool), 0 means 4 per thread
+    **/
+    Collection(const std::vector<URI>& uris,
+        unsigned int options = NO_MODIFIER,
+        unsigned int nThreads = 0,
+        size_t maxInFlight = 0);
+
+    /**
+       Create a collection from all the SWC, ASC, H5 and MBIN files of a
+       directory (not recursive), sorted by name
+    **/
+    static Collection fromDirectory(const URI& directory,
+        unsigned int options = NO_MODIFIER,
+        unsigned int nThreads = 0,
+        size_t maxInFlight = 0);
+
+    /**
+       Load all files and return the results in input order
+    **/
+    std::vector<LoadResult> load() const;
+
+    /**
+       Load all files and hand each result to the callback
+
+       The callback is always called from the calling thread, either as soon
+       as each file is loaded or, if ordered is true, in input order.
+       If the callback throws, the loading is stopped and the exception is
+       rethrown once all threads are done.
+    **/
+    void load(const Callback& callback, bool ordered = false) const;
+
+    const std::vector<URI>& uris() const;
+    size_t size() const;
+    unsigned int threads() const;
+    size_t maxInFlight() const;
+
+private:
+    std::vector<URI> _uris;
+    unsigned int _options;
+    unsigned int _nThreads;
+    size_t _maxInFlight;
+};
+} // namespace morphio
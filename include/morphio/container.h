@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory> // std::shared_ptr
+#include <string> // std::string
+#include <vector> // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+namespace readers {
+namespace h5 {
+class ContainerFile;
+}
+} // namespace readers
+
+/**
+   An HDF5 file holding many morphologies, opened once
+
+   Opening and parsing the metadata of an HDF5 file often costs more than
+   reading the few datasets of a morphology. A container concatenates the
+   datasets of many morphologies in one file, in the H5 version 1.1 layout
+   read by Morphology:
+
+   - /points (N x 4): the (x, y, z, diameter) rows of all the cells
+   - /structure (S x 3): the (offset, type, parent) rows of all the cells,
+     offsets and parents relative to the first row of their cell
+   - /perimeters (N): only if a cell has perimeters
+   - /organelles/mitochondria/points (M x 3) and structure (K x 2): only if
+     a cell has mitochondria
+   - /index/names (C): the names of the cells
+   - /index/offsets ((C + 1) x 4): the first row of each cell in points,
+     structure, mitochondria points and mitochondria structure, the last row
+     holding the total sizes
+   - /index/cell_family (C) and /index/has_perimeters (C)
+
+   The index datasets are extendible, the names being written last: after
+   an interrupted write, the other index datasets can have one more row,
+   which is ignored.
+
+   Morphology(container, name) reads only the rows of the requested cell,
+   through the file kept open by the container. Containers are written by
+   mut::writer::ContainerWriter.
+
+   Example:
+       Container container("cells.h5");
+       for (const auto& name : container.names())
+           Morphology morphology(container, name);
+**/
+class Container
+{
+public:
+    explicit Container(const URI& uri);
+
+    /**
+       The names of the cells, in the order they were written
+    **/
+    const std::vector<std::string>& names() const;
+
+    bool contains(const std::string& name) const;
+    size_t size() const;
+
+private:
+    friend class Morphology;
+
+    std::shared_ptr<const readers::h5::ContainerFile> _file;
+};
+} // namespace morphio
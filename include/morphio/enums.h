@@ -20,7 +20,13 @@ enum Option
     TWO_POINTS_SECTIONS = 0x01,
     SOMA_SPHERE = 0x02,
     NO_DUPLICATES = 0x04,
-    NRN_ORDER = 0x08
+    NRN_ORDER = 0x08,
+    // H5 only, ignored when combined with a modifier: the neurite points,
+    // diameters and perimeters are read on first access
+    LAZY_LOAD = 0x10,
+    // Same as LAZY_LOAD but accessing the data of a section only reads the
+    // data of this section
+    LAZY_LOAD_SECTIONS = 0x20
 };
 
 /**
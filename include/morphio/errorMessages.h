@@ -128,6 +128,8 @@ public:
 
     const std::string ERROR_OPENING_FILE() const;
 
+    const std::string ERROR_DECOMPRESSING_FILE(const std::string& reason) const;
+
     const std::string ERROR_LINE_NON_PARSABLE(long unsigned int lineNumber) const;
 
     const std::string ERROR_UNSUPPORTED_SECTION_TYPE(long unsigned int lineNumber,
@@ -203,6 +205,10 @@ public:
     std::string WARNING_WRONG_DUPLICATE(
         std::shared_ptr<morphio::mut::Section> current,
         std::shared_ptr<morphio::mut::Section> parent) const;
+    std::string WARNING_WRONG_DUPLICATE(uint32_t currentId,
+        uint32_t parentId,
+        const Property::PointLevel& current,
+        const Property::PointLevel& parent) const;
     std::string WARNING_APPENDING_EMPTY_SECTION(std::shared_ptr<morphio::mut::Section>);
     const std::string WARNING_ONLY_CHILD(const DebugInfo& info, unsigned int parentId,
         unsigned int childId) const;
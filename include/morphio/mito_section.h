@@ -6,9 +6,9 @@
 #include <morphio/types.h>
 
 namespace morphio {
-using mito_upstream_iterator = upstream_iterator_t<MitoSection>;
-using mito_breadth_iterator = morphio::breadth_iterator_t<MitoSection, Mitochondria>;
-using mito_depth_iterator = morphio::depth_iterator_t<MitoSection, Mitochondria>;
+using mito_upstream_iterator = section_upstream_iterator_t<MitoSection>;
+using mito_breadth_iterator = section_order_iterator_t<MitoSection>;
+using mito_depth_iterator = section_order_iterator_t<MitoSection>;
 
 class MitoSection : public SectionBase<MitoSection>
 {
@@ -64,6 +64,8 @@ protected:
     }
     friend const MitoSection Mitochondria::section(const uint32_t&) const;
     friend class SectionBase<MitoSection>;
+    friend class section_order_iterator_t<MitoSection>;
+    friend class section_upstream_iterator_t<MitoSection>;
     friend class mut::MitoSection;
 };
 } // namespace morphio
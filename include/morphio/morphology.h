@@ -1,20 +1,28 @@
 #pragma once
 
 #include <memory> //std::unique_ptr
+#include <set>    // std::set
 
 #include <morphio/section_iterators.hpp>
 #include <morphio/properties.h>
+#include <morphio/section_ref.h>
 #include <morphio/types.h>
 
 namespace morphio {
+namespace mut {
+namespace writer {
+void binary(const morphio::Morphology& morphology, const std::string& filename);
+} // namespace writer
+} // namespace mut
+
 enum SomaClasses
 {
     SOMA_CONTOUR,
     SOMA_CYLINDER
 };
 
-using breadth_iterator = breadth_iterator_t<Section, Morphology>;
-using depth_iterator = depth_iterator_t<Section, Morphology>;
+using breadth_iterator = section_order_iterator_t<Section>;
+using depth_iterator = section_order_iterator_t<Section>;
 
 /** Read access a Morphology file.
  *
@@ -37,10 +45,45 @@ public:
         options is the modifier flags to be applied. All flags are defined in
        their enum: morphio::enum::Option and can be composed.
 
+        sectionTypes restricts the loading to the neurites whose root section
+        has one of the given types, the other neurites are not read. An empty
+        set (the default) loads all the neurites.
+
         Example:
             Morphology("neuron.asc", TWO_POINTS_SECTIONS | SOMA_SPHERE);
+            Morphology("neuron.h5", NO_MODIFIER, {SECTION_DENDRITE, SECTION_APICAL_DENDRITE});
      */
-    Morphology(const URI& source, unsigned int options = NO_MODIFIER);
+    Morphology(const URI& source,
+        unsigned int options = NO_MODIFIER,
+        const std::set<SectionType>& sectionTypes = {});
+
+    /** Parse a morphology from the content of a file held in memory
+
+        extension is the format of the content: "swc", "asc", "h5" or "mbin"
+        (a leading dot is accepted). For "h5", contents is the image of a
+        whole HDF5 file, opened with the in-memory HDF5 core driver.
+
+        Example:
+            Morphology(contents, "swc", NO_DUPLICATES);
+     */
+    Morphology(const std::string& contents,
+        const std::string& extension,
+        unsigned int options = NO_MODIFIER,
+        const std::set<SectionType>& sectionTypes = {});
+
+    /** Read the cell name of a container (see Container)
+
+        Only the rows of the cell are read, through the file opened by the
+        container.
+
+        Example:
+            Morphology(container, "cell_1", NO_DUPLICATES);
+     */
+    Morphology(const Container& container,
+        const std::string& name,
+        unsigned int options = NO_MODIFIER,
+        const std::set<SectionType>& sectionTypes = {});
+
     Morphology(mut::Morphology);
 
     /**
@@ -69,6 +112,14 @@ public:
      **/
     const std::vector<Section> sections() const;
 
+    /**
+     * Return non-owning handles on all sections, without allocating
+     *
+     * The handles must not be used after this morphology (and the sections
+     * sharing its data) have been deallocated.
+     **/
+    SectionRefs sectionRefs() const;
+
     /**
      * Return the Section with the given id.
      *
@@ -82,6 +133,12 @@ public:
      **/
     const Points& points() const;
 
+    /**
+     * Return the points of points() as aligned x, y and z arrays, built on
+     * the first call and shared by all the users of this morphology
+     **/
+    const Property::PointColumns& pointColumns() const;
+
     /**
      * Return a vector with all diameters from all sections
      * (soma points are not included)
@@ -131,11 +188,27 @@ public:
     const MorphologyVersion& version() const;
 
 private:
+    friend class Archive;
+    friend class Collection;
     friend class mut::Morphology;
+    friend void mut::writer::binary(const Morphology& morphology, const std::string& filename);
     friend bool diff(const Morphology& left, const Morphology& right, morphio::enums::LogLevel verbose);
 
     std::shared_ptr<Property::Properties> _properties;
 
+    // Parse the size bytes at data, source is only used in error messages
+    Morphology(const URI& source,
+        const char* data,
+        size_t size,
+        const std::string& extension,
+        unsigned int options,
+        const std::set<SectionType>& sectionTypes);
+
+    // Finish the construction once _properties has been loaded
+    void _init(const std::string& extension,
+        unsigned int options,
+        const std::set<SectionType>& sectionTypes);
+
     template <typename Property>
     const std::vector<typename Property::Type>& get() const;
 };
@@ -12,12 +12,16 @@ class MitoSection
 public:
     MitoSection(Mitochondria* mitochondria, unsigned int id,
         const Property::MitochondriaPointLevel& pointProperties);
+    MitoSection(Mitochondria* mitochondria, unsigned int id,
+        Property::MitochondriaPointLevel&& pointProperties);
     MitoSection(Mitochondria* mitochondria, unsigned int id,
         const morphio::MitoSection& section);
     MitoSection(Mitochondria* mitochondria, unsigned int id, const MitoSection& section);
 
     std::shared_ptr<MitoSection> appendSection(
         const Property::MitochondriaPointLevel& points);
+    std::shared_ptr<MitoSection> appendSection(
+        Property::MitochondriaPointLevel&& points);
 
     std::shared_ptr<MitoSection> appendSection(
         std::shared_ptr<MitoSection> original_section, bool recursive);
@@ -87,6 +87,8 @@ public:
     **/
     MitoSectionP appendRootSection(
         const Property::MitochondriaPointLevel& points);
+    MitoSectionP appendRootSection(
+        Property::MitochondriaPointLevel&& points);
 
     /**
        Append a root MitoSection
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <memory>
 #include <ostream>
+#include <set>
 
 #include <functional>
 
@@ -18,6 +19,10 @@
 
 namespace morphio {
 namespace mut {
+namespace writer {
+struct H5Options;
+}
+
 bool _checkDuplicatePoint(std::shared_ptr<Section> parent,
     std::shared_ptr<Section> current);
 
@@ -38,10 +43,25 @@ public:
        options is the modifier flags to be applied. All flags are defined in
     their enum: morphio::enum::Option and can be composed.
 
+       sectionTypes restricts the loading to the neurites of the given types,
+       see morphio::Morphology
+
        Example:
            Morphology("neuron.asc", TWO_POINTS_SECTIONS | SOMA_SPHERE);
     **/
-    Morphology(const morphio::URI& uri, unsigned int options = NO_MODIFIER);
+    Morphology(const morphio::URI& uri,
+        unsigned int options = NO_MODIFIER,
+        const std::set<SectionType>& sectionTypes = {});
+
+    /**
+       Build a mutable Morphology from the content of a file held in memory
+
+       See morphio::Morphology for the supported extensions
+    **/
+    Morphology(const std::string& contents,
+        const std::string& extension,
+        unsigned int options = NO_MODIFIER,
+        const std::set<SectionType>& sectionTypes = {});
 
     /**
        Build a mutable Morphology from a mutable morphology
@@ -145,6 +165,12 @@ public:
     std::shared_ptr<Section> appendRootSection(const Property::PointLevel&,
         SectionType sectionType);
 
+    /**
+       Append a root Section, moving the point level data in it
+    **/
+    std::shared_ptr<Section> appendRootSection(Property::PointLevel&&,
+        SectionType sectionType);
+
     void applyModifiers(unsigned int modifierFlags);
 
     /**
@@ -156,6 +182,7 @@ public:
      * Return the cell family (neuron or glia)
      **/
     CellFamily& cellFamily() { return _cellProperties->_cellFamily; }
+    CellFamily cellFamily() const { return _cellProperties->_cellFamily; }
 
     /**
      * Return the version
@@ -167,6 +194,12 @@ public:
      **/
     void write(const std::string& filename);
 
+    /**
+     * Same as write(filename), the H5 datasets being stored with the given
+     * chunking and compression options
+     **/
+    void write(const std::string& filename, const writer::H5Options& options);
+
     void addAnnotation(const morphio::Property::Annotation& annotation)
     {
         _annotations.push_back(annotation);
@@ -102,6 +102,13 @@ public:
         const Property::PointLevel&,
         SectionType sectionType = SectionType::SECTION_UNDEFINED);
 
+    /**
+       Same as above but the point level data is moved in the new section
+    **/
+    std::shared_ptr<Section> appendSection(
+        Property::PointLevel&&,
+        SectionType sectionType = SectionType::SECTION_UNDEFINED);
+
 private:
     friend class Morphology;
 
@@ -109,7 +116,7 @@ private:
     // https://stackoverflow.com/questions/8202530/how-can-i-call-a-private-destructor-from-a-shared-ptr
     friend void friendDtorForSharedPtr(Section*);
 
-    Section(Morphology*, unsigned int id, SectionType type, const Property::PointLevel&);
+    Section(Morphology*, unsigned int id, SectionType type, Property::PointLevel&&);
     Section(Morphology*, unsigned int id, const morphio::Section& section);
     Section(Morphology*, unsigned int id, const Section&);
 
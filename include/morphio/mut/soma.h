@@ -13,6 +13,7 @@ public:
     }
 
     Soma(const Property::PointLevel& pointProperties);
+    Soma(Property::PointLevel&& pointProperties);
     Soma(const Soma& soma);
     Soma(const morphio::Soma& soma);
 
@@ -1,3 +1,5 @@
+#include <memory> // std::unique_ptr
+
 #include <morphio/mut/mitochondria.h>
 #include <morphio/mut/morphology.h>
 
@@ -6,7 +8,78 @@ namespace mut {
 namespace writer {
 void swc(const Morphology& morphology, const std::string& filename);
 void asc(const Morphology& morphology, const std::string& filename);
-void h5(const Morphology& morphology, const std::string& filename);
+
+/**
+   Storage options of the datasets written by h5() and ContainerWriter
+
+   The shuffle and deflate filters of HDF5 compress the datasets chunk by
+   chunk, chunkSize being the number of rows of a chunk. On the points of
+   morphologies, shuffle with deflate level 1 saves about a third of the
+   size while higher levels barely do better, but inflating is slower than
+   reading a local disk: the filters are off by default, and h5() then
+   writes contiguous datasets.
+**/
+struct H5Options
+{
+    size_t chunkSize = 1 << 14;
+    unsigned int deflateLevel = 0; // 0 (no compression) to 9
+    bool shuffle = false;
+};
+
+void h5(const Morphology& morphology,
+    const std::string& filename,
+    const H5Options& options = H5Options());
+
+/**
+   Write the morphology in the MorphIO native binary format (.mbin)
+**/
+void binary(const Morphology& morphology, const std::string& filename);
+void binary(const morphio::Morphology& morphology, const std::string& filename);
+
+/**
+   Write many morphologies in one HDF5 container (see morphio::Container)
+
+   Each add() appends the rows of a morphology to the extendible datasets of
+   the file, then its name and offsets to the extendible index datasets,
+   and flushes the file: a container can be read up to the last cell added,
+   even if its writer was not closed. Only the names of the cells are kept
+   in memory. The destructor closes the container but ignores the errors.
+
+   With append, an existing container is opened and its index extended,
+   the options then only apply to the datasets not created yet.
+
+   add() can be called from several threads: the morphologies are converted
+   concurrently, then appended one at a time.
+
+   Example:
+       ContainerWriter writer("cells.h5");
+       for (const auto& name : names)
+           writer.add(name, Morphology(name + ".swc"));
+       writer.close();
+**/
+class ContainerWriter
+{
+public:
+    explicit ContainerWriter(const std::string& filename,
+        const H5Options& options = H5Options(),
+        bool append = false);
+    ~ContainerWriter();
+
+    ContainerWriter(const ContainerWriter&) = delete;
+    ContainerWriter& operator=(const ContainerWriter&) = delete;
+
+    /**
+       Append a morphology, throw a WriterError if name is already used
+    **/
+    void add(const std::string& name, const Morphology& morphology);
+    void add(const std::string& name, const morphio::Morphology& morphology);
+
+    void close();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
+};
 } // namespace writer
 } // end namespace mut
 } // end namespace morphio
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <future> // std::future
+#include <memory> // std::unique_ptr
+#include <set>    // std::set
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+#include <morphio/collection.h>
+#include <morphio/types.h>
+
+namespace morphio {
+/**
+   Load a morphology on a new thread
+
+   The returned future holds the morphology or rethrows the exception of its
+   loading. A started load can not be cancelled: to load many files ahead of
+   their use, see Prefetcher.
+
+   Example:
+       auto future = loadAsync("neuron.h5");
+       ... // compute something else
+       Morphology morphology = future.get();
+**/
+std::future<Morphology> loadAsync(const URI& uri,
+    unsigned int options = NO_MODIFIER,
+    const std::set<SectionType>& sectionTypes = {});
+
+/**
+   Load a list of files in the background, a bounded number of files ahead
+   of the consumer
+
+   The files are handed to the consumer in input order by next(). At most
+   depth files are loaded or being loaded but not yet handed out, so that
+   the loading overlaps the processing of the previous morphologies without
+   holding the whole list in memory. A file failing to load is reported in
+   its LoadResult, as with Collection.
+
+   Example:
+       Prefetcher prefetcher(uris, NO_DUPLICATES, 4);
+       LoadResult result;
+       while (prefetcher.next(result))
+           if (result.morphology)
+               ...
+
+   The destructor cancels the files not yet started and waits for the ones
+   being loaded.
+**/
+class Prefetcher
+{
+public:
+    /**
+       - depth: the maximum number of files loaded ahead of the consumer,
+         0 means 2 per thread
+       - nThreads: the number of loading threads
+    **/
+    Prefetcher(const std::vector<URI>& uris,
+        unsigned int options = NO_MODIFIER,
+        size_t depth = 0,
+        unsigned int nThreads = 1);
+    ~Prefetcher();
+
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    /**
+       Wait for the next file in input order and move its result into result
+
+       Return false, leaving result untouched, once all files have been
+       handed out or after cancel().
+    **/
+    bool next(LoadResult& result);
+
+    /**
+       Stop loading: the files not yet started are skipped and next()
+       returns false. Safe to call from any thread.
+    **/
+    void cancel();
+
+    size_t size() const;
+    size_t depth() const;
+
+private:
+    struct State;
+
+    std::unique_ptr<State> _state;
+    std::vector<std::thread> _threads;
+};
+} // namespace morphio
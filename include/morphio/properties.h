@@ -20,6 +20,9 @@
 #pragma once
 
 #include <map>
+#include <memory> // std::shared_ptr, std::unique_ptr
+#include <mutex>  // std::mutex
+
 #include <morphio/types.h>
 
 namespace morphio {
@@ -93,17 +96,73 @@ struct PointLevel
         std::vector<Diameter::Type> diameters,
         std::vector<Perimeter::Type> perimeters = std::vector<Perimeter::Type>());
     PointLevel(const PointLevel& data);
+    PointLevel(PointLevel&& data) = default;
     PointLevel(const PointLevel& data, SectionRange range);
     PointLevel& operator=(const PointLevel& other);
+    PointLevel& operator=(PointLevel&& other) = default;
     // bool operator==(const PointLevel& other) const;
     // bool operator!=(const PointLevel& other) const;
 };
 
+/**
+   The children of each section, in compressed sparse row form
+
+   The children of section i are _ids[_offsets[i]:_offsets[i + 1]] and the
+   root sections are in _roots, all in increasing id order. The sections
+   whose parent does not exist are nobody's children.
+
+   The depth first and breadth first orders of the sections reachable from
+   the roots are computed along: in _depthFirst, section i is at
+   _depthPositions[i] and followed by its descendants up to _subtreeEnds[i].
+**/
+struct Children
+{
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _ids;
+    std::vector<uint32_t> _roots;
+
+    std::vector<uint32_t> _depthFirst;
+    std::vector<uint32_t> _breadthFirst;
+    std::vector<uint32_t> _depthPositions;
+    std::vector<uint32_t> _subtreeEnds;
+
+    Children() {}
+    /**
+       Index the children of the given (offset, parent) sections
+    **/
+    explicit Children(const std::vector<Section::Type>& sections);
+
+    range<const uint32_t> children(uint32_t sectionId) const;
+    range<const uint32_t> roots() const;
+
+    /**
+       The sections reachable from the roots, root after root
+    **/
+    range<const uint32_t> depthFirst() const;
+    range<const uint32_t> breadthFirst() const;
+
+    /**
+       The section followed by its descendants in depth first order, as a
+       view of depthFirst(). Empty if the section is not reachable from a
+       root, see depthFirst(sectionId).
+    **/
+    range<const uint32_t> subtree(uint32_t sectionId) const;
+
+    /**
+       The section followed by its descendants, computed on each call
+    **/
+    std::vector<uint32_t> depthFirst(uint32_t sectionId) const;
+    std::vector<uint32_t> breadthFirst(uint32_t sectionId) const;
+
+    bool operator==(const Children& other) const;
+    bool operator!=(const Children& other) const;
+};
+
 struct SectionLevel
 {
     std::vector<Section::Type> _sections;
     std::vector<SectionType::Type> _sectionTypes;
-    std::map<int, std::vector<unsigned int>> _children;
+    Children _children;
 
     bool operator==(const SectionLevel& other) const;
     bool operator!=(const SectionLevel& other) const;
@@ -143,7 +202,7 @@ struct MitochondriaPointLevel
 struct MitochondriaSectionLevel
 {
     std::vector<Section::Type> _sections;
-    std::map<int, std::vector<unsigned int>> _children;
+    Children _children;
 
     bool diff(const MitochondriaSectionLevel& other, LogLevel logLevel) const;
     bool operator==(const MitochondriaSectionLevel& other) const;
@@ -173,6 +232,109 @@ struct CellLevel
     bool operator!=(const CellLevel& other) const;
 };
 
+/**
+   The point coordinates as three separate float arrays (structure of
+   arrays), for vectorized kernels
+
+   Each array starts on an alignment byte boundary and is zero padded up to
+   paddedSize() elements, so that SIMD loops can run over whole registers
+   without a scalar tail.
+**/
+class PointColumns
+{
+public:
+    static const size_t alignment = 64;
+
+    explicit PointColumns(const std::vector<Point::Type>& points);
+
+    /**
+       Bytes allocated for the columns of size points
+    **/
+    static size_t memoryUsage(size_t size);
+
+    size_t size() const
+    {
+        return _size;
+    }
+    size_t paddedSize() const
+    {
+        return _stride;
+    }
+
+    /**
+       The coordinate axis (0 for x, 1 for y, 2 for z) of all points
+    **/
+    range<const float> column(size_t axis) const;
+    range<const float> x() const
+    {
+        return column(0);
+    }
+    range<const float> y() const
+    {
+        return column(1);
+    }
+    range<const float> z() const
+    {
+        return column(2);
+    }
+
+private:
+    std::unique_ptr<float[]> _buffer;
+    float* _data;
+    size_t _size;
+    size_t _stride;
+};
+
+/**
+   The PointColumns of the points of a Properties, built on first use
+
+   Copies start empty: the copied Properties can be modified before the
+   columns are requested again.
+**/
+class PointColumnsCache
+{
+public:
+    PointColumnsCache() {}
+    PointColumnsCache(const PointColumnsCache&) {}
+    PointColumnsCache& operator=(const PointColumnsCache&);
+
+    const PointColumns& get(const std::vector<Point::Type>& points) const;
+
+private:
+    mutable std::mutex _mutex;
+    mutable std::unique_ptr<const PointColumns> _columns;
+};
+
+/**
+   Deferred reading of the neurite point level data (points, diameters and
+   perimeters) of a morphology, see Option::LAZY_LOAD
+
+   Implementations must be thread-safe: load() can be called concurrently
+   and the elements already read must not move in memory.
+**/
+class PointLevelLoader
+{
+public:
+    virtual ~PointLevelLoader();
+
+    /**
+       Number of points, known without reading them
+    **/
+    virtual size_t size() const = 0;
+
+    /**
+       Return the point level with at least the points in [start, end) read,
+       all vectors being already sized to size() (or empty for perimeters if
+       there are none)
+    **/
+    virtual PointLevel& load(size_t start, size_t end) = 0;
+
+    /**
+       Bytes held once all the points are read
+    **/
+    virtual size_t memoryUsage() const = 0;
+};
+
 // The lowest level data blob
 struct Properties
 {
@@ -190,6 +352,12 @@ struct Properties
 
     std::vector<Annotation> _annotations;
 
+    // When set, _pointLevel is unused and the neurite point level data is
+    // read from the loader on first access
+    std::shared_ptr<PointLevelLoader> _pointLoader;
+
+    PointColumnsCache _pointColumns;
+
     ////////////////////////////////////////////////////////////////////////////////
     // Functions
     ////////////////////////////////////////////////////////////////////////////////
@@ -198,18 +366,43 @@ struct Properties
     template <typename T>
     const std::vector<typename T::Type>& get() const;
 
+    /**
+       Like get<T>() but when the point level data is lazily loaded, only the
+       elements in range are guaranteed to be read
+    **/
+    template <typename T>
+    const std::vector<typename T::Type>& get(SectionRange) const
+    {
+        return get<T>();
+    }
+
+    /**
+       Same as get<T>().size() without reading lazily loaded data
+    **/
+    template <typename T>
+    size_t size() const
+    {
+        return get<T>().size();
+    }
+
     const morphio::MorphologyVersion& version() { return _cellLevel._version; }
     const morphio::CellFamily& cellFamily() { return _cellLevel._cellFamily; }
     const morphio::SomaType& somaType() { return _cellLevel._somaType; }
     template <typename T>
-    const std::map<int32_t, std::vector<uint32_t>>& children();
+    const Children& children() const;
+
+    /**
+       The neurite point coordinates as columns, built (and lazily loaded
+       points read) on the first call and cached: the points must not be
+       modified afterwards
+    **/
+    const PointColumns& pointColumns() const;
 };
 
 template <>
-const std::map<int32_t, std::vector<uint32_t>>& Properties::children<Section>();
+const Children& Properties::children<Section>() const;
 template <>
-const std::map<int32_t, std::vector<uint32_t>>&
-    Properties::children<MitoSection>();
+const Children& Properties::children<MitoSection>() const;
 
 std::ostream& operator<<(std::ostream& os, const Properties& properties);
 std::ostream& operator<<(std::ostream& os, const PointLevel& pointLevel);
@@ -217,6 +410,16 @@ std::ostream& operator<<(std::ostream& os, const PointLevel& pointLevel);
 template <>
 std::vector<Point::Type>& Properties::get<Point>();
 template <>
+const std::vector<Point::Type>& Properties::get<Point>(SectionRange range) const;
+template <>
+const std::vector<Diameter::Type>& Properties::get<Diameter>(SectionRange range) const;
+template <>
+const std::vector<Perimeter::Type>& Properties::get<Perimeter>(SectionRange range) const;
+template <>
+size_t Properties::size<Point>() const;
+template <>
+size_t Properties::size<Diameter>() const;
+template <>
 std::vector<Perimeter::Type>& Properties::get<Perimeter>();
 template <>
 std::vector<Diameter::Type>& Properties::get<Diameter>();
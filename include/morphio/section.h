@@ -29,9 +29,9 @@ namespace morphio {
  * is a Section referring to it.
  */
 
-using upstream_iterator = upstream_iterator_t<Section>;
-using breadth_iterator = breadth_iterator_t<Section, Morphology>;
-using depth_iterator = depth_iterator_t<Section, Morphology>;
+using upstream_iterator = section_upstream_iterator_t<Section>;
+using breadth_iterator = section_order_iterator_t<Section>;
+using depth_iterator = section_order_iterator_t<Section>;
 
 class Section : public SectionBase<Section>
 {
@@ -64,6 +64,12 @@ public:
     **/
     const range<const Point> points() const;
 
+    /**
+     * Return views to the x, y and z coordinates of this section's points,
+     * in the morphology's point columns (see Morphology::pointColumns)
+     **/
+    const std::array<range<const float>, 3> pointColumns() const;
+
     /**
      * Return a view
     (https://github.com/isocpp/CppCoreGuidelines/blob/master/docs/gsl-intro.md#gslspan-what-is-gslspan-and-what-is-it-for)
@@ -85,6 +91,8 @@ public:
     friend class mut::Section;
     friend const Section Morphology::section(const uint32_t&) const;
     friend class SectionBase<Section>;
+    friend class section_order_iterator_t<Section>;
+    friend class section_upstream_iterator_t<Section>;
 
 protected:
     Section(uint32_t id_, std::shared_ptr<Property::Properties> properties)
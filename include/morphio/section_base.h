@@ -57,6 +57,11 @@ public:
 
 protected:
     SectionBase(uint32_t id, std::shared_ptr<Property::Properties> properties);
+
+    // The iterators over this section and its descendants
+    section_order_iterator_t<T> _depthBegin() const;
+    section_order_iterator_t<T> _breadthBegin() const;
+
     template <typename Property>
     const range<const typename Property::Type> get() const;
 
@@ -7,15 +7,15 @@ template <typename T>
 SectionBase<T>::SectionBase(const uint32_t id_,
     std::shared_ptr<Property::Properties> properties)
     : _id(id_)
-    , _properties(properties)
+    , _properties(std::move(properties))
 {
-    const auto& sections = properties->get<typename T::SectionId>();
+    const auto& sections = _properties->get<typename T::SectionId>();
     if (_id >= sections.size())
         LBTHROW(RawDataError("Requested section ID (" + std::to_string(_id) + ") is out of array bounds (array size = " + std::to_string(sections.size()) + ")"));
 
     const size_t start = static_cast<size_t>(sections[_id][0]);
     const size_t end = _id == sections.size() - 1
-                           ? properties->get<typename T::PointAttribute>().size()
+                           ? _properties->size<typename T::PointAttribute>()
                            : static_cast<size_t>(sections[_id + 1][0]);
 
     _range = std::make_pair(start, end);
@@ -67,7 +67,7 @@ template <typename T>
 template <typename TProperty>
 const range<const typename TProperty::Type> SectionBase<T>::get() const
 {
-    auto& data = _properties->get<TProperty>();
+    auto& data = _properties->get<TProperty>(_range);
     if (data.empty())
         return range<const typename TProperty::Type>();
 
@@ -76,6 +76,23 @@ const range<const typename TProperty::Type> SectionBase<T>::get() const
         _range.second - _range.first);
 }
 
+template <typename T>
+section_order_iterator_t<T> SectionBase<T>::_depthBegin() const
+{
+    const auto& children = _properties->children<typename T::SectionId>();
+    const auto subtree = children.subtree(_id);
+    if (!subtree.empty())
+        return section_order_iterator_t<T>(_properties, subtree);
+    return section_order_iterator_t<T>(_properties, children.depthFirst(_id));
+}
+
+template <typename T>
+section_order_iterator_t<T> SectionBase<T>::_breadthBegin() const
+{
+    return section_order_iterator_t<T>(_properties,
+        _properties->children<typename T::SectionId>().breadthFirst(_id));
+}
+
 template <typename T>
 bool SectionBase<T>::isRoot() const
 {
@@ -97,17 +114,26 @@ T SectionBase<T>::parent() const
 template <typename T>
 const std::vector<T> SectionBase<T>::children() const
 {
+    const auto ids = _properties->children<typename T::SectionId>().children(_id);
     std::vector<T> result;
-    try {
-        const std::vector<uint32_t>& _children = _properties->children<typename T::SectionId>().at(static_cast<int>(_id));
-        result.reserve(_children.size());
-        for (const uint32_t id_ : _children)
-            result.push_back(T(id_, _properties));
-
-        return result;
-    } catch (const std::out_of_range&) {
-        return result;
-    }
+    result.reserve(ids.size());
+    for (const uint32_t id_ : ids)
+        result.push_back(T(id_, _properties));
+    return result;
+}
+
+template <typename SectionT>
+section_upstream_iterator_t<SectionT> section_upstream_iterator_t<SectionT>::operator++()
+{
+    if (_id == -1)
+        LBTHROW(MissingParentError("Cannot call iterate upstream past the root node"));
+
+    const auto& sections = _properties->get<typename SectionT::SectionId>();
+    const int32_t parent = sections[static_cast<size_t>(_id)][1];
+    if (parent < -1 || static_cast<int64_t>(parent) >= static_cast<int64_t>(sections.size()))
+        LBTHROW(RawDataError("Section " + std::to_string(_id) + " has an invalid parent: " + std::to_string(parent)));
+    _id = parent;
+    return *this;
 }
 
 } // namespace morphio
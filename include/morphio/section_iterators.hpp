@@ -4,6 +4,7 @@
 #include <deque> // std::deque
 #include <iterator> // std::back_inserter / std::front_inserter
 #include <memory> // std::shared_ptr
+#include <utility> // std::move
 #include <vector> // std::vector
 
 #include <morphio/types.h>
@@ -253,4 +254,129 @@ private:
     bool end;
 };
 
+/**
+   Iterator over the read-only sections whose ids are listed in a traversal
+   order, such as the depth first and breadth first orders precomputed in
+   Property::Children
+
+   Incrementing and comparing iterators is a matter of indices: the
+   sections are only created when dereferenced. Dereferencing still shares
+   the properties with the returned section (a reference count increment),
+   loops that do not need Section objects can use the SectionRef handles of
+   Morphology::sectionRefs() instead.
+**/
+template<typename SectionT>
+class section_order_iterator_t {
+public:
+    section_order_iterator_t()
+    : _position(0)
+    {}
+
+    // ids must stay valid as long as the iterator, like the orders of properties
+    section_order_iterator_t(std::shared_ptr<Property::Properties> properties,
+                             range<const uint32_t> ids)
+    : _properties(std::move(properties))
+    , _ids(ids)
+    , _position(0)
+    {}
+
+    section_order_iterator_t(std::shared_ptr<Property::Properties> properties,
+                             std::vector<uint32_t>&& ids)
+    : _properties(std::move(properties))
+    , _storage(std::make_shared<const std::vector<uint32_t>>(std::move(ids)))
+    , _ids(_storage->data(), _storage->data() + _storage->size())
+    , _position(0)
+    {}
+
+    SectionT operator*() const
+    {
+        return SectionT(_ids[_position], _properties);
+    }
+
+    section_order_iterator_t operator++()
+    {
+        if (_position >= _ids.size()) {
+            LBTHROW(MorphioError("Can't iterate past the end"));
+        }
+        ++_position;
+        return *this;
+    }
+
+    section_order_iterator_t operator++(int)
+    {
+        section_order_iterator_t ret(*this);
+        ++(*this);
+        return ret;
+    }
+
+    bool operator==(const section_order_iterator_t& other) const
+    {
+        const bool atEnd = _position >= _ids.size();
+        if (atEnd || other._position >= other._ids.size()) {
+            return atEnd && other._position >= other._ids.size();
+        }
+        return _ids.data() == other._ids.data() && _position == other._position;
+    }
+
+    bool operator!=(const section_order_iterator_t& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<Property::Properties> _properties;
+    // Set when the order is not one of the properties
+    std::shared_ptr<const std::vector<uint32_t>> _storage;
+    range<const uint32_t> _ids;
+    size_t _position;
+};
+
+/**
+   Iterator from a read-only section up to its root, following the parent
+   ids
+**/
+template<typename SectionT>
+class section_upstream_iterator_t {
+public:
+    section_upstream_iterator_t()
+    : _id(-1)
+    {}
+
+    section_upstream_iterator_t(std::shared_ptr<Property::Properties> properties,
+                                uint32_t id)
+    : _properties(std::move(properties))
+    , _id(static_cast<int32_t>(id))
+    {}
+
+    SectionT operator*() const
+    {
+        return SectionT(static_cast<uint32_t>(_id), _properties);
+    }
+
+    // Defined in section_base.tpp, with the properties
+    section_upstream_iterator_t operator++();
+
+    section_upstream_iterator_t operator++(int)
+    {
+        section_upstream_iterator_t ret(*this);
+        ++(*this);
+        return ret;
+    }
+
+    bool operator==(const section_upstream_iterator_t& other) const
+    {
+        return _id == other._id && (_id == -1 || _properties == other._properties);
+    }
+
+    bool operator!=(const section_upstream_iterator_t& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<Property::Properties> _properties;
+    // -1 past the root
+    int32_t _id;
+};
+
 } // namespace morphio
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstdint>  // uint32_t
+#include <iterator> // std::forward_iterator_tag
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+namespace morphio {
+class SectionRefs;
+
+/**
+ * A non-owning handle on a section of a read-only morphology
+ *
+ * Unlike Section, a SectionRef is trivially copyable: it only holds a raw
+ * pointer to the morphology data and the section id, the point range of
+ * the section being computed when needed. It must not be used after the
+ * last Morphology (or Section) sharing that data has been deallocated.
+ *
+ * Meant for the loops that visit every section of many morphologies.
+ */
+class SectionRef
+{
+public:
+    SectionRef()
+        : _properties(nullptr)
+        , _id(0)
+    {}
+
+    SectionRef(const Property::Properties* properties, uint32_t id)
+        : _properties(properties)
+        , _id(id)
+    {}
+
+    /** Return the ID of this section. */
+    uint32_t id() const
+    {
+        return _id;
+    }
+
+    /**
+     * Return true if this section is a root section (parent ID == -1)
+     **/
+    bool isRoot() const;
+
+    /**
+     * Return the parent section of this section
+     *
+     * @throw MissingParentError is the section doesn't have a parent.
+     */
+    SectionRef parent() const;
+
+    /**
+     * Return the children sections, in increasing id order
+     */
+    SectionRefs children() const;
+
+    /**
+     * Return the morphological type of this section (dendrite, axon, ...)
+     */
+    SectionType type() const;
+
+    /**
+     * Return views to the point coordinates, diameters and perimeters of
+     * this section
+     **/
+    range<const Point> points() const;
+    range<const float> diameters() const;
+    range<const float> perimeters() const;
+
+    bool operator==(const SectionRef& other) const
+    {
+        return _properties == other._properties && _id == other._id;
+    }
+    bool operator!=(const SectionRef& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    SectionRange _range() const;
+    template <typename Property>
+    range<const typename Property::Type> _get() const;
+
+    const Property::Properties* _properties;
+    uint32_t _id;
+};
+
+/**
+ * A range of SectionRef: either all the sections of a morphology or the
+ * sections of a list of ids (such as the children of a section)
+ *
+ * No allocation is made, the ids being read from the morphology data.
+ */
+class SectionRefs
+{
+public:
+    /**
+     * Holds a copy of the range fields rather than a pointer to the range,
+     * so that iterating over a temporary range (such as
+     * `for (auto child : section.children())`) is valid
+     **/
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = SectionRef;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const SectionRef*;
+        using reference = SectionRef;
+
+        iterator(const Property::Properties* properties, const uint32_t* ids, size_t index)
+            : _properties(properties)
+            , _ids(ids)
+            , _index(index)
+        {}
+
+        SectionRef operator*() const
+        {
+            return SectionRef(_properties, _ids ? _ids[_index] : static_cast<uint32_t>(_index));
+        }
+        iterator& operator++()
+        {
+            ++_index;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator ret(*this);
+            ++_index;
+            return ret;
+        }
+        bool operator==(const iterator& other) const
+        {
+            return _index == other._index && _ids == other._ids &&
+                   _properties == other._properties;
+        }
+        bool operator!=(const iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        const Property::Properties* _properties;
+        const uint32_t* _ids;
+        size_t _index;
+    };
+
+    SectionRefs()
+        : _properties(nullptr)
+        , _ids(nullptr)
+        , _size(0)
+    {}
+
+    /**
+     * The sections 0 to size - 1
+     **/
+    SectionRefs(const Property::Properties* properties, size_t size)
+        : _properties(properties)
+        , _ids(nullptr)
+        , _size(size)
+    {}
+
+    /**
+     * The sections of the given ids, which must outlive the range
+     **/
+    SectionRefs(const Property::Properties* properties, range<const uint32_t> ids)
+        : _properties(properties)
+        , _ids(ids.data())
+        , _size(ids.size())
+    {}
+
+    SectionRef operator[](size_t index) const
+    {
+        return SectionRef(_properties, _ids ? _ids[index] : static_cast<uint32_t>(index));
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    iterator begin() const
+    {
+        return iterator(_properties, _ids, 0);
+    }
+    iterator end() const
+    {
+        return iterator(_properties, _ids, _size);
+    }
+
+private:
+    const Property::Properties* _properties;
+    const uint32_t* _ids;
+    size_t _size;
+};
+
+} // namespace morphio
@@ -17,6 +17,8 @@ namespace morphio {
 using URI = std::string;
 
 using namespace enums;
+class Archive;
+class Container;
 class Morphology;
 template <class T>
 class SectionBase;
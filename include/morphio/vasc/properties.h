@@ -48,8 +48,10 @@ struct VascPointLevel
     VascPointLevel(std::vector<Point::Type> points,
         std::vector<Diameter::Type> diameters);
     VascPointLevel(const VascPointLevel& data);
+    VascPointLevel(VascPointLevel&& data) = default;
     VascPointLevel(const VascPointLevel& data, SectionRange range);
     VascPointLevel& operator=(const VascPointLevel&) = default;
+    VascPointLevel& operator=(VascPointLevel&&) = default;
 };
 
 struct VascEdgeLevel
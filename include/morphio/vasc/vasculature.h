@@ -21,6 +21,12 @@ public:
      */
     explicit Vasculature(const std::string& source);
 
+    /** Parse a vasculature from the image of an HDF5 file held in memory
+
+        extension must be "h5"
+     */
+    Vasculature(const std::string& contents, const std::string& extension);
+
     Vasculature(Vasculature&&) = default;
     virtual ~Vasculature() {}
 
@@ -0,0 +1,58 @@
+#!/usr/bin/env python
+'''Time the loading of Neurolucida files, one file at a time
+
+Usage: benchmark_asc.py [--repeat N] [files or directories...]
+
+Without argument, the .asc files of tests/data are loaded. Run it against
+two builds of morphio to compare the per-file load time.
+'''
+import argparse
+import os
+import time
+
+import morphio
+
+
+def _asc_files(paths):
+    for path in paths:
+        if os.path.isdir(path):
+            for name in sorted(os.listdir(path)):
+                if name.lower().endswith('.asc'):
+                    yield os.path.join(path, name)
+        else:
+            yield path
+
+
+def main():
+    default_data = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'tests', 'data')
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('paths', nargs='*', default=[default_data])
+    parser.add_argument('--repeat', type=int, default=200,
+                        help='number of times each file is loaded')
+    args = parser.parse_args()
+
+    morphio.set_maximum_warnings(0)
+
+    total, count = 0., 0
+    for path in _asc_files(args.paths):
+        try:
+            morphio.Morphology(path)
+        except morphio.MorphioError:
+            continue
+
+        start = time.time()
+        for _ in range(args.repeat):
+            morphio.Morphology(path)
+        elapsed = time.time() - start
+
+        total += elapsed
+        count += args.repeat
+        print('{:>10.1f} us  {}'.format(1e6 * elapsed / args.repeat, path))
+
+    if count:
+        print('{:>10.1f} us  mean per file'.format(1e6 * total / count))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+'''Compare the size and the load time of H5 morphologies written with
+different chunking and compression options
+
+Usage: benchmark_h5.py [--repeat N] [files or directories...]
+
+Without argument, the .h5 files of tests/data/h5/v1 are used. Each file is
+rewritten with every option set in a temporary directory and reloaded. The
+files are in the page cache after the first load: the times measure the
+decompression, to be weighed against the reading time of the saved bytes
+on the target storage.
+'''
+import argparse
+import os
+import shutil
+import tempfile
+import time
+
+import morphio
+from morphio.mut import H5Options
+
+# (deflate level, shuffle)
+_FILTERS = [(0, False), (1, False), (1, True), (4, True), (9, True)]
+
+
+def _h5_files(paths):
+    for path in paths:
+        if os.path.isdir(path):
+            for name in sorted(os.listdir(path)):
+                if name.lower().endswith('.h5'):
+                    yield os.path.join(path, name)
+        else:
+            yield path
+
+
+def _options(chunk_size, deflate_level, shuffle):
+    options = H5Options()
+    options.chunk_size = chunk_size
+    options.deflate_level = deflate_level
+    options.shuffle = shuffle
+    return options
+
+
+def main():
+    default_data = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', 'tests', 'data', 'h5', 'v1')
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('paths', nargs='*', default=[default_data])
+    parser.add_argument('--repeat', type=int, default=100,
+                        help='number of times each file is loaded')
+    parser.add_argument('--chunk-size', type=int, default=H5Options().chunk_size,
+                        help='number of rows of a chunk')
+    args = parser.parse_args()
+
+    morphio.set_maximum_warnings(0)
+
+    morphologies = []
+    for path in _h5_files(args.paths):
+        try:
+            morphologies.append(morphio.mut.Morphology(path))
+        except morphio.MorphioError:
+            continue
+
+    tmp_folder = tempfile.mkdtemp()
+    try:
+        for deflate_level, shuffle in _FILTERS:
+            options = _options(args.chunk_size, deflate_level, shuffle)
+            size, elapsed = 0, 0.
+            for i, morphology in enumerate(morphologies):
+                path = os.path.join(tmp_folder, '{}.h5'.format(i))
+                morphology.write(path, options)
+                size += os.path.getsize(path)
+
+                morphio.Morphology(path)
+                start = time.time()
+                for _ in range(args.repeat):
+                    morphio.Morphology(path)
+                elapsed += time.time() - start
+
+            print('deflate {} shuffle {:d}: {:>10} bytes {:>10.1f} us per file'.format(
+                deflate_level, shuffle, size,
+                1e6 * elapsed / max(1, args.repeat * len(morphologies))))
+    finally:
+        shutil.rmtree(tmp_folder)
+
+
+if __name__ == '__main__':
+    main()
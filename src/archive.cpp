@@ -0,0 +1,58 @@
+#include <morphio/archive.h>
+
+#include <morphio/morphology.h>
+
+#include "readers/memoryMap.h"
+#include "readers/tar.h"
+
+namespace morphio {
+Archive::Archive(const URI& uri)
+    : _uri(uri)
+    , _map(std::make_shared<readers::MemoryMap>(uri, false))
+{
+    const auto members = readers::tar::index(uri, _map->data(), _map->size());
+    _names.reserve(members.size());
+    _members.reserve(members.size());
+    for (const auto& member : members) {
+        // When a name is stored twice, the last copy wins, as with tar -x
+        if (_members.count(member.name) == 0)
+            _names.push_back(member.name);
+        _members[member.name] = Range{member.offset, member.size};
+    }
+}
+
+const std::vector<std::string>& Archive::names() const
+{
+    return _names;
+}
+
+bool Archive::contains(const std::string& name) const
+{
+    return _members.count(name) > 0;
+}
+
+size_t Archive::size() const
+{
+    return _names.size();
+}
+
+Morphology Archive::morphology(const std::string& name,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes) const
+{
+    const auto it = _members.find(name);
+    if (it == _members.end())
+        LBTHROW(RawDataError("Tar archive '" + _uri + "' has no member: " + name));
+
+    const size_t pos = name.find_last_of("./");
+    if (pos == std::string::npos || name[pos] != '.')
+        LBTHROW(UnknownFileType("File has no extension"));
+
+    return Morphology(_uri + "/" + name,
+        _map->data() + it->second.offset,
+        it->second.size,
+        name.substr(pos),
+        options,
+        sectionTypes);
+}
+} // namespace morphio
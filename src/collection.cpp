@@ -0,0 +1,244 @@
+#include <morphio/collection.h>
+
+#include <algorithm>          // std::sort, std::transform
+#include <cctype>             // std::tolower
+#include <condition_variable> // std::condition_variable
+#include <dirent.h>           // opendir / readdir / closedir
+#include <exception>          // std::exception_ptr
+#include <map>                // std::map
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+
+#include <morphio/cache.h>
+#include <morphio/morphology.h>
+
+#include "readers/fileBatch.h"
+
+namespace morphio {
+namespace {
+// The maximum number of files a worker claims at once, their contents are
+// read in one batch before being parsed. A worker never claims more than its
+// share of the remaining files, so that the last files (and all the files of
+// small collections) are still spread on every thread.
+const size_t _batchSize = 16;
+
+std::string _lowerExtension(const std::string& name, size_t end)
+{
+    const size_t pos = end == 0 ? std::string::npos : name.find_last_of(".", end - 1);
+    if (pos == std::string::npos)
+        return "";
+
+    std::string extension = name.substr(pos, end - pos);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+bool _isMorphologyFile(const std::string& name)
+{
+    std::string extension = _lowerExtension(name, name.size());
+    // Only the text formats can be gzip compressed
+    if (extension == ".gz") {
+        extension = _lowerExtension(name, name.size() - extension.size());
+        return extension == ".swc" || extension == ".asc";
+    }
+    return extension == ".swc" || extension == ".asc" || extension == ".h5" ||
+           extension == ".mbin";
+}
+
+// The formats parsed from the content of the file rather than from its path,
+// H5 files are opened by the HDF5 library and gzip files by zlib
+bool _isReadInBatch(const std::string& name)
+{
+    const std::string extension = _lowerExtension(name, name.size());
+    return extension == ".swc" || extension == ".asc" || extension == ".mbin";
+}
+} // namespace
+
+Collection::Collection(const std::vector<URI>& uris,
+    unsigned int options,
+    unsigned int nThreads,
+    size_t maxInFlight)
+    : _uris(uris)
+    , _options(options)
+    , _nThreads(nThreads > 0 ? nThreads : std::max(1u, std::thread::hardware_concurrency()))
+    , _maxInFlight(maxInFlight > 0 ? maxInFlight : 4 * _nThreads)
+{
+}
+
+Collection Collection::fromDirectory(const URI& directory,
+    unsigned int options,
+    unsigned int nThreads,
+    size_t maxInFlight)
+{
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr)
+        LBTHROW(RawDataError("Could not open directory: " + directory));
+
+    const std::string prefix = directory.empty() || directory.back() == '/' ? directory
+                                                                            : directory + "/";
+    std::vector<URI> uris;
+    while (const dirent* entry = readdir(dir)) {
+        const std::string name(entry->d_name);
+        if (_isMorphologyFile(name))
+            uris.push_back(prefix + name);
+    }
+    closedir(dir);
+
+    std::sort(uris.begin(), uris.end());
+    return Collection(uris, options, nThreads, maxInFlight);
+}
+
+std::vector<LoadResult> Collection::load() const
+{
+    std::vector<LoadResult> results(_uris.size());
+    load([&results](LoadResult&& result) { results[result.index] = std::move(result); });
+    return results;
+}
+
+void Collection::load(const Callback& callback, bool ordered) const
+{
+    const size_t nFiles = _uris.size();
+
+    // Everything below is protected by mutex
+    std::mutex mutex;
+    std::condition_variable workerCondition;
+    std::condition_variable resultCondition;
+    size_t next = 0;     // index of the next file to be loaded
+    size_t inFlight = 0; // files being loaded or loaded but not yet delivered
+    bool stop = false;
+    std::map<size_t, LoadResult> ready;
+
+    auto worker = [&]() {
+        std::vector<size_t> indices;
+        std::vector<URI> batchUris;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workerCondition.wait(lock, [&]() {
+                    return stop || next >= nFiles || inFlight < _maxInFlight;
+                });
+                if (stop || next >= nFiles)
+                    return;
+                const size_t share = (nFiles - next + _nThreads - 1) / _nThreads;
+                const size_t count = std::min(std::min(_batchSize, share),
+                    _maxInFlight - inFlight);
+                indices.clear();
+                for (size_t i = 0; i < count; ++i)
+                    indices.push_back(next++);
+                inFlight += count;
+            }
+
+            // The cache is keyed by file, cached files go through Morphology(uri)
+            batchUris.clear();
+            if (cache_capacity() == 0)
+                for (size_t index : indices)
+                    if (_isReadInBatch(_uris[index]))
+                        batchUris.push_back(_uris[index]);
+            const auto contents = readers::readFiles(batchUris);
+
+            size_t batchPosition = 0;
+            for (size_t index : indices) {
+                const URI& uri = _uris[index];
+                const readers::FileContent* content = nullptr;
+                if (batchPosition < batchUris.size() && batchUris[batchPosition] == uri)
+                    content = &contents[batchPosition++];
+
+                LoadResult result{index, uri, nullptr, ""};
+                try {
+                    // Files that could not be read are given to Morphology(uri)
+                    // for its usual error messages
+                    if (content != nullptr && content->error.empty())
+                        result.morphology = std::make_shared<Morphology>(Morphology(uri,
+                            content->data.data(),
+                            content->data.size(),
+                            _lowerExtension(uri, uri.size()),
+                            _options,
+                            {}));
+                    else
+                        result.morphology = std::make_shared<Morphology>(uri, _options);
+                } catch (const std::exception& e) {
+                    result.error = e.what();
+                } catch (...) {
+                    result.error = "Unknown error while loading " + uri;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ready.emplace(index, std::move(result));
+                }
+                resultCondition.notify_one();
+            }
+        }
+    };
+
+    auto stopAndJoin = [&](std::vector<std::thread>& threads) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        workerCondition.notify_all();
+        for (auto& thread : threads)
+            thread.join();
+    };
+
+    std::vector<std::thread> threads;
+    try {
+        const size_t nThreads = std::min(static_cast<size_t>(_nThreads), nFiles);
+        for (size_t i = 0; i < nThreads; ++i)
+            threads.emplace_back(worker);
+    } catch (...) {
+        stopAndJoin(threads);
+        throw;
+    }
+
+    // With ordered delivery, inFlight == next - delivered so that the bound
+    // on inFlight also bounds the reordering buffer
+    std::exception_ptr exception;
+    for (size_t delivered = 0; delivered < nFiles; ++delivered) {
+        LoadResult result;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            resultCondition.wait(lock, [&]() {
+                return !ready.empty() && (!ordered || ready.begin()->first == delivered);
+            });
+            result = std::move(ready.begin()->second);
+            ready.erase(ready.begin());
+            --inFlight;
+        }
+        workerCondition.notify_one();
+
+        try {
+            callback(std::move(result));
+        } catch (...) {
+            exception = std::current_exception();
+            break;
+        }
+    }
+
+    stopAndJoin(threads);
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+const std::vector<URI>& Collection::uris() const
+{
+    return _uris;
+}
+
+size_t Collection::size() const
+{
+    return _uris.size();
+}
+
+unsigned int Collection::threads() const
+{
+    return _nThreads;
+}
+
+size_t Collection::maxInFlight() const
+{
+    return _maxInFlight;
+}
+
+} // namespace morphio
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <mutex>
 #include <morphio/errorMessages.h>
 #include <sstream>
 
@@ -32,6 +33,8 @@ void set_ignored_warning(const std::vector<Warning>& warnings, bool ignore)
 void LBERROR(Warning warning, const std::string& msg)
 {
     static int error = 0;
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
     if (readers::ErrorMessages::isIgnored(warning) || MORPHIO_MAX_N_WARNINGS == 0)
         return;
 
@@ -73,6 +76,11 @@ const std::string ErrorMessages::ERROR_OPENING_FILE() const
     return "Error opening morphology file:\n" + errorMsg(0, ErrorLevel::ERROR);
 }
 
+const std::string ErrorMessages::ERROR_DECOMPRESSING_FILE(const std::string& reason) const
+{
+    return "Error decompressing morphology file: " + reason + "\n" + errorMsg(0, ErrorLevel::ERROR);
+}
+
 const std::string ErrorMessages::ERROR_LINE_NON_PARSABLE(long unsigned int lineNumber) const
 {
     return errorMsg(lineNumber, ErrorLevel::ERROR, "Unable to parse this line");
@@ -229,7 +237,7 @@ const std::string ErrorMessages::ERROR_UNCOMPATIBLE_FLAGS(
 const std::string ErrorMessages::ERROR_WRONG_EXTENSION(
     const std::string filename) const
 {
-    return "Filename: " + filename + " must have one of the following extensions: swc, asc or h5";
+    return "Filename: " + filename + " must have one of the following extensions: swc, asc, h5 or mbin";
 }
 
 std::string ErrorMessages::ERROR_VECTOR_LENGTH_MISMATCH(const std::string& vec1,
@@ -274,25 +282,34 @@ std::string ErrorMessages::WARNING_APPENDING_EMPTY_SECTION(std::shared_ptr<morph
 std::string ErrorMessages::WARNING_WRONG_DUPLICATE(
     std::shared_ptr<morphio::mut::Section> current,
     std::shared_ptr<morphio::mut::Section> parent) const
+{
+    return WARNING_WRONG_DUPLICATE(current->id(), parent->id(), current->properties(),
+        parent->properties());
+}
+
+std::string ErrorMessages::WARNING_WRONG_DUPLICATE(uint32_t currentId,
+    uint32_t parentId,
+    const Property::PointLevel& current,
+    const Property::PointLevel& parent) const
 {
     std::string msg(
-        "While appending section: " + std::to_string(current->id()) + " to parent: " + std::to_string(parent->id()));
+        "While appending section: " + std::to_string(currentId) + " to parent: " + std::to_string(parentId));
 
-    if (parent->points().empty())
+    if (parent._points.empty())
         return errorMsg(0, ErrorLevel::WARNING,
             msg + "\nThe parent section is empty.");
 
-    if (current->points().empty())
+    if (current._points.empty())
         return errorMsg(0, ErrorLevel::WARNING,
             msg +
                 "\nThe current section has no points. It should at "
                 "least contains " +
                 "parent section last point");
 
-    auto p0 = parent->points()[parent->points().size() - 1];
-    auto p1 = current->points()[0];
-    auto d0 = parent->diameters()[parent->diameters().size() - 1];
-    auto d1 = current->diameters()[0];
+    auto p0 = parent._points[parent._points.size() - 1];
+    auto p1 = current._points[0];
+    auto d0 = parent._diameters[parent._diameters.size() - 1];
+    auto d1 = current._diameters[0];
 
     return errorMsg(0, ErrorLevel::WARNING,
         msg + "\nThe section first point " + "should be parent section last point: " + "\n        : X Y Z Diameter" + "\nparent last point :[" + std::to_string(p0[0]) + ", " + std::to_string(p0[1]) + ", " + std::to_string(p0[2]) + ", " + std::to_string(d0) + "]" + "\nchild first point :[" + std::to_string(p1[0]) + ", " + std::to_string(p1[1]) + ", " + std::to_string(p1[2]) + ", " + std::to_string(d1) + "]\n");
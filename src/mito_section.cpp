@@ -6,7 +6,7 @@ namespace morphio {
 
 mito_depth_iterator MitoSection::depth_begin() const
 {
-    return mito_depth_iterator(*this);
+    return _depthBegin();
 }
 
 mito_depth_iterator MitoSection::depth_end() const
@@ -16,7 +16,7 @@ mito_depth_iterator MitoSection::depth_end() const
 
 mito_breadth_iterator MitoSection::breadth_begin() const
 {
-    return mito_breadth_iterator(*this);
+    return _breadthBegin();
 }
 
 mito_breadth_iterator MitoSection::breadth_end() const
@@ -26,7 +26,7 @@ mito_breadth_iterator MitoSection::breadth_end() const
 
 mito_upstream_iterator MitoSection::upstream_begin() const
 {
-    return mito_upstream_iterator(*this);
+    return mito_upstream_iterator(_properties, _id);
 }
 
 mito_upstream_iterator MitoSection::upstream_end() const
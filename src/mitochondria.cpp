@@ -19,19 +19,12 @@ const std::vector<MitoSection> Mitochondria::sections() const
 
 const std::vector<MitoSection> Mitochondria::rootSections() const
 {
+    const auto roots = _properties->children<morphio::Property::MitoSection>().roots();
     std::vector<MitoSection> result;
-    try {
-        const std::vector<uint32_t>& children = _properties->children<morphio::Property::MitoSection>().at(-1);
-
-        result.reserve(children.size());
-        for (auto id : children) {
-            result.push_back(section(id));
-        }
-
-        return result;
-    } catch (const std::out_of_range&) {
-        return result;
-    }
+    result.reserve(roots.size());
+    for (auto id : roots)
+        result.push_back(section(id));
+    return result;
 }
 
 } // namespace morphio
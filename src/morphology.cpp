@@ -1,9 +1,8 @@
 #include <cassert>
 #include <iostream>
+#include <unistd.h> // access / F_OK
 
-#include <fstream>
-#include <streambuf>
-
+#include <morphio/container.h>
 #include <morphio/mitochondria.h>
 #include <morphio/morphology.h>
 #include <morphio/section.h>
@@ -12,7 +11,12 @@
 
 #include <morphio/mut/morphology.h>
 
+#include "propertiesCache.h"
+#include "propertiesModifiers.h"
+#include "readers/containerHDF5.h"
+#include "readers/gzip.h"
 #include "readers/morphologyASC.h"
+#include "readers/morphologyBinary.h"
 #include "readers/morphologyHDF5.h"
 #include "readers/morphologySWC.h"
 
@@ -20,49 +24,139 @@ namespace morphio {
 void buildChildren(std::shared_ptr<Property::Properties> properties);
 SomaType getSomaType(long unsigned int nSomaPoints);
 
-Morphology::Morphology(const URI& source, unsigned int options)
+Morphology::Morphology(const URI& source,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
 {
-    const size_t pos = source.find_last_of(".");
+    // The extension of a gzip compressed file is the one before .gz
+    const bool compressed = readers::gzip::isCompressed(source);
+    const size_t last = source.find_last_of(".");
+    const size_t pos = compressed && last != 0 ? source.find_last_of(".", last - 1) : last;
     if (pos == std::string::npos)
         LBTHROW(UnknownFileType("File has no extension"));
 
-    // Cross-platform check of file existance
-    std::ifstream file(source.c_str());
-    if (!file) {
+    if (access(source.c_str(), F_OK) == -1)
         LBTHROW(RawDataError("File: " + source + " does not exist."));
-    }
 
-    std::string extension = source.substr(pos);
+    const std::string extension = source.substr(pos, compressed ? last - pos : std::string::npos);
+
+    cache::Key key;
+    const bool cached = cache::makeKey(source, options, sectionTypes, key);
+    if (cached) {
+        _properties = cache::find(key);
+        if (_properties)
+            return;
+    }
 
-    auto loader = [&source, &options, &extension]() {
+    auto loader = [&source, &options, &sectionTypes, &extension, compressed]() {
+        if (compressed) {
+            if (extension == ".asc" || extension == ".ASC" || extension == ".swc" ||
+                extension == ".SWC") {
+                const std::string contents = readers::gzip::inflate(source);
+                return extension == ".asc" || extension == ".ASC"
+                           ? readers::asc::load(source, contents.data(), contents.size(), options, sectionTypes)
+                           : readers::swc::load(source, contents.data(), contents.size(), options, sectionTypes);
+            }
+            LBTHROW(UnknownFileType(
+                "Unhandled compressed file type: only SWC and ASC files can be gzip compressed"));
+        }
         if (extension == ".h5" || extension == ".H5")
-            return readers::h5::load(source);
+            return readers::h5::load(source, options, sectionTypes);
         if (extension == ".asc" || extension == ".ASC")
-            return readers::asc::load(source, options);
+            return readers::asc::load(source, options, sectionTypes);
         if (extension == ".swc" || extension == ".SWC")
-            return readers::swc::load(source, options);
+            return readers::swc::load(source, options, sectionTypes);
+        if (extension == ".mbin" || extension == ".MBIN")
+            return readers::binary::load(source);
         LBTHROW(UnknownFileType(
-            "Unhandled file type: only SWC, ASC and H5 are supported"));
+            "Unhandled file type: only SWC, ASC, H5 and MBIN are supported"));
     };
 
     _properties = std::make_shared<Property::Properties>(loader());
+    _init(extension, options, sectionTypes);
 
-    buildChildren(_properties);
+    if (cached)
+        cache::insert(key, _properties);
+}
 
+Morphology::Morphology(const std::string& contents,
+    const std::string& extension,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+    : Morphology("$STRING$", contents.data(), contents.size(), extension, options, sectionTypes)
+{
+}
+
+Morphology::Morphology(const URI& source,
+    const char* data,
+    size_t size,
+    const std::string& extension,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+{
+    const std::string ext = extension.empty() || extension[0] == '.' ? extension
+                                                                     : "." + extension;
+
+    auto loader = [&source, data, size, &options, &sectionTypes, &ext]() {
+        if (ext == ".h5" || ext == ".H5")
+            return readers::h5::load(source, data, size, sectionTypes);
+        if (ext == ".asc" || ext == ".ASC")
+            return readers::asc::load(source, data, size, options, sectionTypes);
+        if (ext == ".swc" || ext == ".SWC")
+            return readers::swc::load(source, data, size, options, sectionTypes);
+        if (ext == ".mbin" || ext == ".MBIN")
+            return readers::binary::load(source, data, size);
+        LBTHROW(UnknownFileType(
+            "Unhandled file type: only SWC, ASC, H5 and MBIN are supported"));
+    };
+
+    _properties = std::make_shared<Property::Properties>(loader());
+    _init(ext, options, sectionTypes);
+}
+
+Morphology::Morphology(const Container& container,
+    const std::string& name,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+    : _properties(std::make_shared<Property::Properties>(
+          container._file->load(name, options, sectionTypes)))
+{
+    _init(".h5", options, sectionTypes);
+}
+
+void Morphology::_init(const std::string& extension,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+{
     if (version() != MORPHOLOGY_VERSION_SWC_1)
         _properties->_cellLevel._somaType = getSomaType(soma().points().size());
 
-    // Sad trick because, contrary to SWC and ASC, H5 does not create a
-    // mut::Morphology object on which we can directly call
-    // mut::Morphology::applyModifiers
-    if (options && (version() == MORPHOLOGY_VERSION_H5_1 || version() == MORPHOLOGY_VERSION_H5_1_1 || version() == MORPHOLOGY_VERSION_H5_2)) {
+    // Contrary to SWC and ASC, H5 and MBIN do not create a mut::Morphology
+    // object on which mut::Morphology::applyModifiers is called, the
+    // modifiers are applied on the loaded arrays
+    const bool modifiersApplied = extension == ".asc" || extension == ".ASC" ||
+                                  extension == ".swc" || extension == ".SWC";
+    const unsigned int modifiers = options & ~static_cast<unsigned int>(LAZY_LOAD | LAZY_LOAD_SECTIONS);
+
+    // The MBIN sections are mapped from the file as a whole, the unselected
+    // neurites are removed afterwards
+    const bool filtered = !sectionTypes.empty() && (extension == ".mbin" || extension == ".MBIN");
+    if (filtered) {
+        buildChildren(_properties);
         mut::Morphology mutable_morph(*this);
+        const auto roots = mutable_morph.rootSections();
+        for (const auto& root : roots)
+            if (sectionTypes.count(root->type()) == 0)
+                mutable_morph.deleteSection(root, true);
         mutable_morph.sanitize();
-        mutable_morph.applyModifiers(options);
+        mutable_morph.applyModifiers(modifiers);
         _properties = std::make_shared<Property::Properties>(
             mutable_morph.buildReadOnly());
-        buildChildren(_properties);
+    } else if (modifiers && !modifiersApplied) {
+        modifiers::apply(*_properties, modifiers);
     }
+
+    buildChildren(_properties);
 }
 
 Morphology::Morphology(mut::Morphology morphology)
@@ -101,18 +195,12 @@ const Section Morphology::section(const uint32_t& id) const
 
 const std::vector<Section> Morphology::rootSections() const
 {
+    const auto roots = _properties->children<morphio::Property::Section>().roots();
     std::vector<Section> result;
-    try {
-        const std::vector<uint32_t>& children = _properties->children<morphio::Property::Section>().at(-1);
-        result.reserve(children.size());
-        for (auto id : children) {
-            result.push_back(section(id));
-        }
-
-        return result;
-    } catch (const std::out_of_range&) {
-        return result;
-    }
+    result.reserve(roots.size());
+    for (auto id : roots)
+        result.push_back(section(id));
+    return result;
 }
 
 const std::vector<Section> Morphology::sections() const
@@ -127,6 +215,11 @@ const std::vector<Section> Morphology::sections() const
     return sections_;
 }
 
+SectionRefs Morphology::sectionRefs() const
+{
+    return SectionRefs(_properties.get(), _properties->get<Property::Section>().size());
+}
+
 template <typename Property>
 const std::vector<typename Property::Type>& Morphology::get() const
 {
@@ -137,6 +230,10 @@ const Points& Morphology::points() const
 {
     return get<Property::Point>();
 }
+const Property::PointColumns& Morphology::pointColumns() const
+{
+    return _properties->pointColumns();
+}
 const std::vector<float>& Morphology::diameters() const
 {
     return get<Property::Diameter>();
@@ -167,7 +264,7 @@ const MorphologyVersion& Morphology::version() const
 
 depth_iterator Morphology::depth_begin() const
 {
-    return depth_iterator(*this);
+    return depth_iterator(_properties, _properties->children<Property::Section>().depthFirst());
 }
 
 depth_iterator Morphology::depth_end() const
@@ -177,7 +274,7 @@ depth_iterator Morphology::depth_end() const
 
 breadth_iterator Morphology::breadth_begin() const
 {
-    return breadth_iterator(*this);
+    return breadth_iterator(_properties, _properties->children<Property::Section>().breadthFirst());
 }
 
 breadth_iterator Morphology::breadth_end() const
@@ -199,25 +296,10 @@ SomaType getSomaType(long unsigned int nSomaPoints)
 
 void buildChildren(std::shared_ptr<Property::Properties> properties)
 {
-    {
-        const auto& sections = properties->get<Property::Section>();
-        auto& children = properties->_sectionLevel._children;
-
-        for (unsigned int i = 0; i < sections.size(); ++i) {
-            const int32_t parent = sections[i][1];
-            children[parent].push_back(i);
-        }
-    }
-
-    {
-        const auto& sections = properties->get<Property::MitoSection>();
-        auto& children = properties->_mitochondriaSectionLevel._children;
-
-        for (unsigned int i = 0; i < sections.size(); ++i) {
-            const int32_t parent = sections[i][1];
-            children[parent].push_back(i);
-        }
-    }
+    properties->_sectionLevel._children = Property::Children(
+        properties->get<Property::Section>());
+    properties->_mitochondriaSectionLevel._children = Property::Children(
+        properties->get<Property::MitoSection>());
 }
 
 } // namespace morphio
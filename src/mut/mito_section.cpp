@@ -1,3 +1,5 @@
+#include <utility> // std::move
+
 #include <morphio/mut/mito_section.h>
 #include <morphio/mut/mitochondria.h>
 
@@ -12,6 +14,15 @@ MitoSection::MitoSection(
 {
 }
 
+MitoSection::MitoSection(
+    Mitochondria* mitochondria, unsigned int id_,
+    Property::MitochondriaPointLevel&& pointProperties)
+    : _id(id_)
+    , _mitochondria(mitochondria)
+    , _mitoPoints(std::move(pointProperties))
+{
+}
+
 MitoSection::MitoSection(Mitochondria* mitochondria, unsigned int id_,
     const morphio::MitoSection& section)
     : MitoSection(mitochondria, id_,
@@ -31,12 +42,18 @@ MitoSection::MitoSection(Mitochondria* mitochondria, unsigned int id_,
 
 std::shared_ptr<MitoSection> MitoSection::appendSection(
     const Property::MitochondriaPointLevel& points)
+{
+    return appendSection(Property::MitochondriaPointLevel(points));
+}
+
+std::shared_ptr<MitoSection> MitoSection::appendSection(
+    Property::MitochondriaPointLevel&& points)
 {
     unsigned int parentId = id();
 
     std::shared_ptr<MitoSection> ptr(new MitoSection(_mitochondria,
                                          _mitochondria->_counter,
-                                         points),
+                                         std::move(points)),
         friendDtorForSharedPtrMito);
 
     uint32_t childId = _mitochondria->_register(ptr);
@@ -97,21 +114,17 @@ const std::shared_ptr<MitoSection> MitoSection::parent() const
 
 bool MitoSection::isRoot() const
 {
-    try {
-        parent();
-        return false;
-    } catch (const std::out_of_range&) {
-        return true;
-    }
+    const auto parent_ = _mitochondria->_parent.find(id());
+    return parent_ == _mitochondria->_parent.end() ||
+           _mitochondria->_sections.count(parent_->second) == 0;
 }
 
 const std::vector<std::shared_ptr<MitoSection>> MitoSection::children() const
 {
-    try {
-        return _mitochondria->_children.at(id());
-    } catch (const std::out_of_range&) {
+    const auto children_ = _mitochondria->_children.find(id());
+    if (children_ == _mitochondria->_children.end())
         return std::vector<std::shared_ptr<MitoSection>>();
-    }
+    return children_->second;
 }
 
 } // namespace mut
@@ -1,4 +1,5 @@
 #include <queue> // std::queue
+#include <utility> // std::move
 #include <morphio/mut/mitochondria.h>
 #include <morphio/mut/writers.h>
 #include <morphio/shared_utils.tpp>
@@ -48,9 +49,15 @@ std::shared_ptr<MitoSection> Mitochondria::appendRootSection(
 
 std::shared_ptr<MitoSection> Mitochondria::appendRootSection(
     const Property::MitochondriaPointLevel& pointProperties)
+{
+    return appendRootSection(Property::MitochondriaPointLevel(pointProperties));
+}
+
+std::shared_ptr<MitoSection> Mitochondria::appendRootSection(
+    Property::MitochondriaPointLevel&& pointProperties)
 {
     std::shared_ptr<MitoSection> ptr(new MitoSection(this, _counter,
-                                         pointProperties),
+                                         std::move(pointProperties)),
         friendDtorForSharedPtrMito);
     _register(ptr);
     _rootSections.push_back(ptr);
@@ -71,11 +78,10 @@ static void _appendMitoProperties(Property::MitochondriaPointLevel& to,
 const std::vector<std::shared_ptr<MitoSection>> Mitochondria::children(
     std::shared_ptr<MitoSection> section_) const
 {
-    try {
-        return _children.at(section_->id());
-    } catch (const std::out_of_range&) {
+    const auto children_ = _children.find(section_->id());
+    if (children_ == _children.end())
         return std::vector<std::shared_ptr<MitoSection>>();
-    }
+    return children_->second;
 }
 
 const std::vector<std::shared_ptr<MitoSection>>& Mitochondria::rootSections()
@@ -92,12 +98,8 @@ const std::shared_ptr<MitoSection> Mitochondria::parent(
 
 bool Mitochondria::isRoot(const std::shared_ptr<MitoSection> section_) const
 {
-    try {
-        parent(section_);
-        return false;
-    } catch (const std::out_of_range&) {
-        return true;
-    }
+    const auto parent_ = _parent.find(section_->id());
+    return parent_ == _parent.end() || _sections.count(parent_->second) == 0;
 }
 
 const std::shared_ptr<MitoSection> Mitochondria::section(uint32_t id) const
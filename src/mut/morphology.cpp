@@ -2,6 +2,7 @@
 
 #include <sstream>
 #include <string>
+#include <utility> // std::move
 
 #include <morphio/mito_section.h>
 #include <morphio/mitochondria.h>
@@ -21,8 +22,18 @@ void eraseByValue(std::vector<std::shared_ptr<Section>>& vec,
     std::shared_ptr<Section> section);
 
 using morphio::readers::ErrorMessages;
-Morphology::Morphology(const morphio::URI& uri, unsigned int options)
-    : Morphology(morphio::Morphology(uri, options))
+Morphology::Morphology(const morphio::URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+    : Morphology(morphio::Morphology(uri, options, sectionTypes))
+{
+}
+
+Morphology::Morphology(const std::string& contents,
+    const std::string& extension,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+    : Morphology(morphio::Morphology(contents, extension, options, sectionTypes))
 {
 }
 
@@ -139,9 +150,15 @@ std::shared_ptr<Section> Morphology::appendRootSection(
 
 std::shared_ptr<Section> Morphology::appendRootSection(
     const Property::PointLevel& pointProperties, SectionType type)
+{
+    return appendRootSection(Property::PointLevel(pointProperties), type);
+}
+
+std::shared_ptr<Section> Morphology::appendRootSection(
+    Property::PointLevel&& pointProperties, SectionType type)
 {
     std::shared_ptr<Section> ptr(new Section(this, _counter, type,
-                                     pointProperties),
+                                     std::move(pointProperties)),
         friendDtorForSharedPtr);
     _register(ptr);
     _rootSections.push_back(ptr);
@@ -389,6 +406,11 @@ void Morphology::applyModifiers(unsigned int modifierFlags)
 }
 
 void Morphology::write(const std::string& filename)
+{
+    write(filename, writer::H5Options());
+}
+
+void Morphology::write(const std::string& filename, const writer::H5Options& options)
 {
     const size_t pos = filename.find_last_of(".");
     assert(pos != std::string::npos);
@@ -407,11 +429,13 @@ void Morphology::write(const std::string& filename)
         extension += my_tolower(c);
 
     if (extension == ".h5")
-        writer::h5(clean, filename);
+        writer::h5(clean, filename, options);
     else if (extension == ".asc")
         writer::asc(clean, filename);
     else if (extension == ".swc")
         writer::swc(clean, filename);
+    else if (extension == ".mbin")
+        writer::binary(clean, filename);
     else
         LBTHROW(UnknownFileType(_err.ERROR_WRONG_EXTENSION(filename)));
 }
@@ -1,4 +1,5 @@
 #include <stack>
+#include <utility> // std::move
 
 #include <morphio/errorMessages.h>
 #include <morphio/mut/morphology.h>
@@ -12,9 +13,9 @@ using morphio::readers::ErrorMessages;
 bool _emptySection(const std::shared_ptr<Section> section);
 
 Section::Section(Morphology* morphology, unsigned int id_, SectionType type_,
-    const Property::PointLevel& pointProperties)
+    Property::PointLevel&& pointProperties)
     : _morphology(morphology)
-    , _pointProperties(pointProperties)
+    , _pointProperties(std::move(pointProperties))
     , _id(id_)
     , _sectionType(type_)
 {
@@ -23,8 +24,10 @@ Section::Section(Morphology* morphology, unsigned int id_, SectionType type_,
 Section::Section(Morphology* morphology, unsigned int id_,
     const morphio::Section& section_)
     : Section(morphology, id_, section_.type(),
-          Property::PointLevel(section_._properties->_pointLevel,
-                  section_._range))
+          Property::PointLevel(
+              std::vector<Point>(section_.points().begin(), section_.points().end()),
+              std::vector<float>(section_.diameters().begin(), section_.diameters().end()),
+              std::vector<float>(section_.perimeters().begin(), section_.perimeters().end())))
 {
 }
 
@@ -43,21 +46,17 @@ const std::shared_ptr<Section> Section::parent() const
 
 bool Section::isRoot() const
 {
-    try {
-        parent();
-        return false;
-    } catch (const std::out_of_range&) {
-        return true;
-    }
+    const auto parent_ = _morphology->_parent.find(id());
+    return parent_ == _morphology->_parent.end() ||
+           _morphology->_sections.count(parent_->second) == 0;
 }
 
 const std::vector<std::shared_ptr<Section>> Section::children() const
 {
-    try {
-        return _morphology->_children.at(id());
-    } catch (const std::out_of_range&) {
+    const auto children_ = _morphology->_children.find(id());
+    if (children_ == _morphology->_children.end())
         return std::vector<std::shared_ptr<Section>>();
-    }
+    return children_->second;
 }
 
 depth_iterator Section::depth_begin() const
@@ -173,6 +172,12 @@ std::shared_ptr<Section> Section::appendSection(const morphio::Section& section,
 
 std::shared_ptr<Section> Section::appendSection(
     const Property::PointLevel& pointProperties, SectionType sectionType)
+{
+    return appendSection(Property::PointLevel(pointProperties), sectionType);
+}
+
+std::shared_ptr<Section> Section::appendSection(
+    Property::PointLevel&& pointProperties, SectionType sectionType)
 {
     unsigned int parentId = id();
 
@@ -185,7 +190,7 @@ std::shared_ptr<Section> Section::appendSection(
             "Cannot create section with type soma"));
 
     Section* p = new Section(_morphology, _morphology->_counter, sectionType,
-        pointProperties);
+        std::move(pointProperties));
 
     std::shared_ptr<Section> ptr(p, friendDtorForSharedPtr);
 
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <utility> // std::move
 
 #include <morphio/mut/soma.h>
 #include <morphio/soma.h>
@@ -14,6 +15,12 @@ Soma::Soma(const Property::PointLevel& pointProperties)
 {
 }
 
+Soma::Soma(Property::PointLevel&& pointProperties)
+    : _somaType(SOMA_UNDEFINED)
+    , _pointProperties(std::move(pointProperties))
+{
+}
+
 Soma::Soma(const Soma& soma)
     : _somaType(soma._somaType)
     , _pointProperties(soma._pointProperties)
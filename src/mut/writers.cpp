@@ -1,6 +1,8 @@
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <unistd.h> // access / F_OK
 
 #include <morphio/errorMessages.h>
 #include <morphio/mut/mitochondria.h>
@@ -13,6 +15,10 @@
 #include <highfive/H5File.hpp>
 #include <highfive/H5Object.hpp>
 
+#include "../readers/containerHDF5.h"
+#include "../readers/morphologyBinary.h"
+#include "../readers/utilsHDF5.h"
+
 namespace morphio {
 namespace mut {
 namespace writer {
@@ -209,24 +215,101 @@ HighFive::Attribute write_attribute(HighFive::Group& group,
 }
 
 template <typename T>
-void write_dataset(HighFive::File& file, const std::string& name, const T& raw)
+void write_dataset(HighFive::File& file, const std::string& name, const T& raw,
+    const HighFive::DataSetCreateProps& props = HighFive::DataSetCreateProps())
 {
     HighFive::DataSet dpoints = file.createDataSet<typename base_type<T>::type>(
-        name, HighFive::DataSpace::From(raw));
+        name, HighFive::DataSpace::From(raw), props);
 
     dpoints.write(raw);
 }
 
 template <typename T>
-void write_dataset(HighFive::Group& file, const std::string& name, const T& raw)
+void write_dataset(HighFive::Group& file, const std::string& name, const T& raw,
+    const HighFive::DataSetCreateProps& props = HighFive::DataSetCreateProps())
 {
     HighFive::DataSet dpoints = file.createDataSet<typename base_type<T>::type>(
-        name, HighFive::DataSpace::From(raw));
+        name, HighFive::DataSpace::From(raw), props);
 
     dpoints.write(raw);
 }
 
-static void mitochondriaH5(HighFive::File& h5_file, const Mitochondria& mitochondria)
+static bool _hasFilters(const H5Options& options)
+{
+    return options.shuffle || options.deflateLevel > 0;
+}
+
+static void _checkOptions(const H5Options& options)
+{
+    if (options.deflateLevel > 9)
+        throw WriterError("The deflate level must be between 0 and 9, not " +
+                          std::to_string(options.deflateLevel));
+    if (options.chunkSize == 0 && _hasFilters(options))
+        throw WriterError("The HDF5 filters need a chunk size greater than 0");
+}
+
+/**
+   The creation properties of a dataset of rows with the given number of
+   columns, 0 for a 1D dataset
+
+   Chunks of maxRows rows at most, as a chunk can not be larger than a
+   dataset of fixed size
+**/
+static HighFive::DataSetCreateProps _createProps(const H5Options& options,
+    size_t maxRows,
+    size_t columns)
+{
+    HighFive::DataSetCreateProps props;
+    std::vector<hsize_t> chunk{std::min(options.chunkSize, maxRows)};
+    if (columns > 0)
+        chunk.push_back(columns);
+    props.add(HighFive::Chunking(chunk));
+    if (options.shuffle)
+        props.add(HighFive::Shuffle());
+    if (options.deflateLevel > 0)
+        props.add(HighFive::Deflate(options.deflateLevel));
+    return props;
+}
+
+template <typename T>
+static size_t _columns(const std::vector<T>&)
+{
+    return 0;
+}
+
+template <typename T>
+static size_t _columns(const std::vector<std::vector<T>>& rows)
+{
+    return rows.empty() ? 0 : rows[0].size();
+}
+
+/**
+   Write the rows as a contiguous dataset, or a chunked one when the
+   options enable filters
+**/
+template <typename Node, typename T>
+void write_rows(Node& node, const std::string& name, const T& rows, const H5Options& options)
+{
+    if (rows.empty() || !_hasFilters(options))
+        write_dataset(node, name, rows);
+    else
+        write_dataset(node, name, rows, _createProps(options, rows.size(), _columns(rows)));
+}
+
+/**
+   The rows of the H5 version 1.1 datasets of a morphology
+**/
+struct H5Rows
+{
+    std::vector<std::vector<float>> points;
+    std::vector<std::vector<int32_t>> structure;
+    std::vector<float> perimeters;
+    bool hasPerimeters = false;
+    std::vector<std::vector<float>> mitoPoints;
+    std::vector<std::vector<int32_t>> mitoStructure;
+};
+
+static void mitochondriaRows(const Mitochondria& mitochondria, H5Rows& rows)
 {
     if (mitochondria.rootSections().empty())
         return;
@@ -236,36 +319,23 @@ static void mitochondriaH5(HighFive::File& h5_file, const Mitochondria& mitochon
     auto& p = properties._mitochondriaPointLevel;
     size_t size = p._diameters.size();
 
-    std::vector<std::vector<float>> points;
-    std::vector<std::vector<int32_t>> structure;
     for (unsigned int i = 0; i < size; ++i) {
-        points.push_back({static_cast<float>(p._sectionIds[i]), p._relativePathLengths[i],
+        rows.mitoPoints.push_back({static_cast<float>(p._sectionIds[i]), p._relativePathLengths[i],
             p._diameters[i]});
     }
 
     auto& s = properties._mitochondriaSectionLevel;
     for (unsigned int i = 0; i < s._sections.size(); ++i) {
-        structure.push_back({s._sections[i][0], s._sections[i][1]});
+        rows.mitoStructure.push_back({s._sections[i][0], s._sections[i][1]});
     }
-
-    HighFive::Group g_organelles = h5_file.createGroup("organelles");
-    HighFive::Group g_mitochondria = g_organelles.createGroup("mitochondria");
-
-    write_dataset(g_mitochondria, "points", points);
-    write_dataset(g_mitochondria, "structure", structure);
 }
 
-void h5(const Morphology& morpho, const std::string& filename)
+static H5Rows h5Rows(const Morphology& morpho)
 {
-    HighFive::File h5_file(filename, HighFive::File::ReadWrite | HighFive::File::Create | HighFive::File::Truncate);
-
+    H5Rows rows;
     int sectionIdOnDisk = 1;
     std::map<uint32_t, int32_t> newIds;
 
-    std::vector<std::vector<float>> raw_points;
-    std::vector<std::vector<int32_t>> raw_structure;
-    std::vector<float> raw_perimeters;
-
     const auto& somaPoints = morpho.soma()->points();
     const auto& somaDiameters = morpho.soma()->diameters();
 
@@ -283,19 +353,20 @@ void h5(const Morphology& morpho, const std::string& filename)
     bool hasPerimeterData = morpho.rootSections().size() > 0
                                 ? morpho.rootSections()[0]->perimeters().size() > 0
                                 : false;
+    rows.hasPerimeters = hasPerimeterData;
 
     for (unsigned int i = 0; i < numberOfSomaPoints; ++i) {
-        raw_points.push_back(
+        rows.points.push_back(
             {somaPoints[i][0], somaPoints[i][1], somaPoints[i][2], somaDiameters[i]});
 
         // If the morphology has some perimeter data, we need to fill some
         // perimeter dummy value in the soma range of the data structure to keep
         // the length matching
         if (hasPerimeterData)
-            raw_perimeters.push_back(0);
+            rows.perimeters.push_back(0);
     }
 
-    raw_structure.push_back({0, SECTION_SOMA, -1});
+    rows.structure.push_back({0, SECTION_SOMA, -1});
     size_t offset = 0;
     offset += morpho.soma()->points().size();
 
@@ -309,10 +380,10 @@ void h5(const Morphology& morpho, const std::string& filename)
 
         const std::size_t numberOfPoints = points.size();
         const std::size_t numberOfPerimeters = perimeters.size();
-        raw_structure.push_back({static_cast<int>(offset), section->type(), parentOnDisk});
+        rows.structure.push_back({static_cast<int>(offset), section->type(), parentOnDisk});
 
         for (unsigned int i = 0; i < numberOfPoints; ++i)
-            raw_points.push_back(
+            rows.points.push_back(
                 {points[i][0], points[i][1], points[i][2], diameters[i]});
 
         if (numberOfPerimeters > 0) {
@@ -322,15 +393,28 @@ void h5(const Morphology& morpho, const std::string& filename)
                         "points", numberOfPoints, "perimeters",
                         numberOfPerimeters));
             for (unsigned int i = 0; i < numberOfPerimeters; ++i)
-                raw_perimeters.push_back(perimeters[i]);
+                rows.perimeters.push_back(perimeters[i]);
         }
 
         newIds[section->id()] = sectionIdOnDisk++;
         offset += numberOfPoints;
     }
 
-    write_dataset(h5_file, "/points", raw_points);
-    write_dataset(h5_file, "/structure", raw_structure);
+    mitochondriaRows(morpho.mitochondria(), rows);
+    return rows;
+}
+
+void h5(const Morphology& morpho, const std::string& filename, const H5Options& options)
+{
+    _checkOptions(options);
+
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::globalHDF5Mutex());
+    HighFive::File h5_file(filename, HighFive::File::ReadWrite | HighFive::File::Create | HighFive::File::Truncate);
+
+    const H5Rows rows = h5Rows(morpho);
+
+    write_rows(h5_file, "/points", rows.points, options);
+    write_rows(h5_file, "/structure", rows.structure, options);
 
     HighFive::Group g_metadata = h5_file.createGroup("metadata");
 
@@ -340,10 +424,321 @@ void h5(const Morphology& morpho, const std::string& filename)
     write_attribute(h5_file, "comment",
         std::vector<std::string>{version_footnote()});
 
-    if (hasPerimeterData)
-        write_dataset(h5_file, "/perimeters", raw_perimeters);
+    if (rows.hasPerimeters)
+        write_rows(h5_file, "/perimeters", rows.perimeters, options);
+
+    if (!rows.mitoPoints.empty() || !rows.mitoStructure.empty()) {
+        HighFive::Group g_organelles = h5_file.createGroup("organelles");
+        HighFive::Group g_mitochondria = g_organelles.createGroup("mitochondria");
+
+        write_rows(g_mitochondria, "points", rows.mitoPoints, options);
+        write_rows(g_mitochondria, "structure", rows.mitoStructure, options);
+    }
+}
+
+struct ContainerWriter::Impl
+{
+    std::unique_ptr<HighFive::File> file;
+    std::unique_ptr<HighFive::DataSet> points;
+    std::unique_ptr<HighFive::DataSet> structure;
+    std::unique_ptr<HighFive::DataSet> perimeters;
+    std::unique_ptr<HighFive::DataSet> mitoPoints;
+    std::unique_ptr<HighFive::DataSet> mitoStructure;
+
+    // The index datasets, extended by each add()
+    std::unique_ptr<HighFive::DataSet> names;
+    std::unique_ptr<HighFive::DataSet> offsets;
+    std::unique_ptr<HighFive::DataSet> families;
+    std::unique_ptr<HighFive::DataSet> hasPerimeters;
+
+    std::set<std::string> usedNames;
+    size_t nCells = 0;
+    // The first row of the next cell in points, structure, mitochondria
+    // points and mitochondria structure
+    std::vector<uint64_t> next = std::vector<uint64_t>(readers::h5::containerOffsetColumns, 0);
+    H5Options options;
+
+    // Serializes the add() of the producer threads
+    std::mutex mutex;
+
+    void createIndex();
+    void openContainer();
+    void appendIndex(const std::string& name,
+        const std::vector<uint64_t>& end,
+        uint32_t family,
+        uint8_t cellHasPerimeters);
+};
+
+namespace {
+// The datasets of a container grow by chunks of options.chunkSize rows
+template <typename T>
+std::unique_ptr<HighFive::DataSet> _createExtensible(HighFive::File& file,
+    const std::string& name,
+    const H5Options& options,
+    size_t columns,
+    size_t rows = 0)
+{
+    std::vector<size_t> dims{rows};
+    std::vector<size_t> maxDims{HighFive::DataSpace::UNLIMITED};
+    if (columns > 0) {
+        dims.push_back(columns);
+        maxDims.push_back(columns);
+    }
+    return std::unique_ptr<HighFive::DataSet>(new HighFive::DataSet(file.createDataSet<T>(
+        name,
+        HighFive::DataSpace(dims, maxDims),
+        _createProps(options, options.chunkSize, columns))));
+}
+
+/**
+   Write value at the given row of a one dimensional dataset, extending it
+**/
+template <typename T>
+void _writeRow(HighFive::DataSet& dataset, size_t row, const T& value)
+{
+    dataset.resize({row + 1});
+    dataset.select({row}, {1}).write(std::vector<T>{value});
+}
+
+/**
+   Append the rows to the dataset whose first free row is start
+**/
+template <typename T>
+void _appendRows(HighFive::DataSet& dataset,
+    uint64_t start,
+    const std::vector<std::vector<T>>& rows,
+    size_t columns)
+{
+    if (rows.empty())
+        return;
+    std::vector<T> buffer;
+    buffer.reserve(rows.size() * columns);
+    for (const auto& row : rows)
+        buffer.insert(buffer.end(), row.begin(), row.end());
+
+    const size_t first = start;
+    dataset.resize({first + rows.size(), columns});
+    dataset.select({first, 0}, {rows.size(), columns}).write(buffer.data());
+}
+} // namespace
+
+/**
+   Create the empty index of a new container, its offsets starting with a
+   row of 0
+**/
+void ContainerWriter::Impl::createIndex()
+{
+    // The index rows are small: they are never compressed
+    H5Options indexOptions;
+    indexOptions.chunkSize = options.chunkSize;
+
+    HighFive::File& h5File = *file;
+    h5File.createGroup(readers::h5::containerIndex);
+    const std::string prefix = "/" + readers::h5::containerIndex + "/";
+    names = _createExtensible<std::string>(h5File, prefix + readers::h5::containerNames, indexOptions, 0);
+    offsets = _createExtensible<uint64_t>(h5File, prefix + readers::h5::containerOffsets,
+        indexOptions, readers::h5::containerOffsetColumns, 1);
+    families = _createExtensible<uint32_t>(h5File, prefix + readers::h5::containerCellFamily, indexOptions, 0);
+    hasPerimeters = _createExtensible<uint8_t>(h5File, prefix + readers::h5::containerHasPerimeters,
+        indexOptions, 0);
+    offsets->write(next.data());
+}
+
+/**
+   Read the index of the container being appended and open its datasets
+**/
+void ContainerWriter::Impl::openContainer()
+{
+    HighFive::File& h5File = *file;
+    const auto open = [&h5File](const std::string& name) {
+        return std::unique_ptr<HighFive::DataSet>(new HighFive::DataSet(h5File.getDataSet(name)));
+    };
+    const std::string prefix = "/" + readers::h5::containerIndex + "/";
+    names = open(prefix + readers::h5::containerNames);
+    offsets = open(prefix + readers::h5::containerOffsets);
+    families = open(prefix + readers::h5::containerCellFamily);
+    hasPerimeters = open(prefix + readers::h5::containerHasPerimeters);
+    if (names->getSpace().getMaxDimensions()[0] != HighFive::DataSpace::UNLIMITED)
+        throw WriterError("Can not append to '" + h5File.getName() +
+                          "': its index is not extendible, the container must be written again");
+
+    std::vector<std::string> cellNames;
+    std::vector<uint32_t> cellFamilies;
+    std::vector<uint8_t> cellHasPerimeters;
+    names->read(cellNames);
+    families->read(cellFamilies);
+    hasPerimeters->read(cellHasPerimeters);
+    nCells = cellNames.size();
+
+    // The other index datasets can have one more row than the names if an
+    // add() was interrupted, those rows are overwritten
+    const auto dims = offsets->getSpace().getDimensions();
+    if (dims.size() != 2 || dims[0] <= nCells ||
+        dims[1] != readers::h5::containerOffsetColumns ||
+        cellFamilies.size() < nCells || cellHasPerimeters.size() < nCells)
+        throw WriterError("Can not append to '" + h5File.getName() + "': bad container index");
+    offsets->select({nCells, 0}, {1, readers::h5::containerOffsetColumns}).read(next.data());
+    usedNames.insert(cellNames.begin(), cellNames.end());
+
+    points = open("/points");
+    structure = open("/structure");
+    if (h5File.exist("perimeters"))
+        perimeters = open("/perimeters");
+    if (h5File.exist("organelles")) {
+        mitoPoints = open("/organelles/mitochondria/points");
+        mitoStructure = open("/organelles/mitochondria/structure");
+    }
+}
+
+/**
+   Append the index entry of the cell just added, whose rows end before the
+   end offsets, its name last: a cell is only part of the container once its
+   name is written. The file is then flushed, so that a container whose
+   writer is not closed can be read up to the last cell added.
+**/
+void ContainerWriter::Impl::appendIndex(const std::string& name,
+    const std::vector<uint64_t>& end,
+    uint32_t family,
+    uint8_t cellHasPerimeters)
+{
+    _writeRow(*families, nCells, family);
+    _writeRow(*hasPerimeters, nCells, cellHasPerimeters);
+    offsets->resize({nCells + 2, readers::h5::containerOffsetColumns});
+    offsets->select({nCells + 1, 0}, {1, readers::h5::containerOffsetColumns}).write(end.data());
+    _writeRow(*names, nCells, name);
+    ++nCells;
+    file->flush();
+}
+
+ContainerWriter::ContainerWriter(const std::string& filename,
+    const H5Options& options,
+    bool append)
+    : _impl(new Impl())
+{
+    _checkOptions(options);
+    if (options.chunkSize == 0)
+        throw WriterError("The datasets of a morphology container need a chunk size greater than 0");
+    _impl->options = options;
+
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::globalHDF5Mutex());
+    if (append && access(filename.c_str(), F_OK) == 0) {
+        try {
+            _impl->file.reset(new HighFive::File(filename, HighFive::File::ReadWrite));
+            _impl->openContainer();
+        } catch (const HighFive::Exception& exc) {
+            throw WriterError("Can not append to '" + filename + "': " + exc.what());
+        }
+        return;
+    }
 
-    mitochondriaH5(h5_file, morpho.mitochondria());
+    _impl->file.reset(new HighFive::File(filename,
+        HighFive::File::ReadWrite | HighFive::File::Create | HighFive::File::Truncate));
+    _impl->points = _createExtensible<float>(*_impl->file, "/points", options, 4);
+    _impl->structure = _createExtensible<int32_t>(*_impl->file, "/structure", options, 3);
+
+    HighFive::Group g_metadata = _impl->file->createGroup("metadata");
+    write_attribute(g_metadata, "version", std::vector<uint32_t>{1, 1});
+    write_attribute(*_impl->file, "comment", std::vector<std::string>{version_footnote()});
+    _impl->createIndex();
+    _impl->file->flush();
+}
+
+ContainerWriter::~ContainerWriter()
+{
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void ContainerWriter::add(const std::string& name, const morphio::Morphology& morphology)
+{
+    add(name, Morphology(morphology));
+}
+
+void ContainerWriter::add(const std::string& name, const Morphology& morphology)
+{
+    // The rows are built concurrently, only the appending is serialized
+    const H5Rows rows = h5Rows(morphology);
+
+    std::lock_guard<std::mutex> appendLock(_impl->mutex);
+    if (!_impl->file)
+        throw WriterError("Can not add '" + name + "' to a closed morphology container");
+    if (_impl->usedNames.count(name) > 0)
+        throw WriterError("The morphology container already has a cell named '" + name + "'");
+
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::globalHDF5Mutex());
+    HighFive::File& file = *_impl->file;
+    const std::vector<uint64_t> first = _impl->next;
+    std::vector<uint64_t> end = first;
+
+    _appendRows(*_impl->points, first[0], rows.points, 4);
+    _appendRows(*_impl->structure, first[1], rows.structure, 3);
+    end[0] += rows.points.size();
+    end[1] += rows.structure.size();
+
+    // The perimeters are parallel to the points, the rows of the cells
+    // without perimeters keep the 0 fill value
+    if (rows.hasPerimeters) {
+        if (!_impl->perimeters)
+            _impl->perimeters = _createExtensible<float>(file, "/perimeters", _impl->options, 0, first[0]);
+        const size_t start = first[0];
+        const size_t count = std::min(rows.perimeters.size(), rows.points.size());
+        _impl->perimeters->resize({start + rows.points.size()});
+        if (count > 0)
+            _impl->perimeters->select({start}, {count}).write(rows.perimeters.data());
+    } else if (_impl->perimeters) {
+        _impl->perimeters->resize({end[0]});
+    }
+
+    if (!rows.mitoPoints.empty() || !rows.mitoStructure.empty()) {
+        if (!_impl->mitoPoints) {
+            HighFive::Group g_organelles = file.createGroup("organelles");
+            g_organelles.createGroup("mitochondria");
+            _impl->mitoPoints = _createExtensible<float>(file, "/organelles/mitochondria/points", _impl->options, 3);
+            _impl->mitoStructure = _createExtensible<int32_t>(file, "/organelles/mitochondria/structure", _impl->options, 2);
+        }
+        _appendRows(*_impl->mitoPoints, first[2], rows.mitoPoints, 3);
+        _appendRows(*_impl->mitoStructure, first[3], rows.mitoStructure, 2);
+        end[2] += rows.mitoPoints.size();
+        end[3] += rows.mitoStructure.size();
+    }
+
+    // The next cell overwrites the rows of this one if its index can not be
+    // written
+    _impl->appendIndex(name, end, morphology.cellFamily(), rows.hasPerimeters ? 1 : 0);
+    _impl->next = end;
+    _impl->usedNames.insert(name);
+}
+
+void ContainerWriter::close()
+{
+    std::lock_guard<std::mutex> appendLock(_impl->mutex);
+    if (!_impl->file)
+        return;
+
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::globalHDF5Mutex());
+    // The index is already complete in the file
+    _impl->hasPerimeters.reset();
+    _impl->families.reset();
+    _impl->offsets.reset();
+    _impl->names.reset();
+    _impl->mitoStructure.reset();
+    _impl->mitoPoints.reset();
+    _impl->perimeters.reset();
+    _impl->structure.reset();
+    _impl->points.reset();
+    _impl->file.reset();
+}
+
+void binary(const Morphology& morpho, const std::string& filename)
+{
+    readers::binary::write(morpho.buildReadOnly(), filename);
+}
+
+void binary(const morphio::Morphology& morpho, const std::string& filename)
+{
+    readers::binary::write(*morpho._properties, filename);
 }
 
 } // end namespace writer
@@ -0,0 +1,142 @@
+#include <morphio/prefetcher.h>
+
+#include <algorithm>          // std::max, std::min
+#include <condition_variable> // std::condition_variable
+#include <map>                // std::map
+#include <mutex>              // std::mutex
+
+#include <morphio/morphology.h>
+
+namespace morphio {
+std::future<Morphology> loadAsync(const URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+{
+    return std::async(std::launch::async, [uri, options, sectionTypes]() {
+        return Morphology(uri, options, sectionTypes);
+    });
+}
+
+struct Prefetcher::State
+{
+    std::vector<URI> uris;
+    unsigned int options;
+    size_t depth;
+
+    // Everything below is protected by mutex
+    std::mutex mutex;
+    std::condition_variable workerCondition;
+    std::condition_variable resultCondition;
+    size_t next = 0;      // index of the next file to be loaded
+    size_t delivered = 0; // index of the next file to be handed out
+    bool cancelled = false;
+    std::map<size_t, LoadResult> ready;
+};
+
+Prefetcher::Prefetcher(const std::vector<URI>& uris,
+    unsigned int options,
+    size_t depth,
+    unsigned int nThreads)
+    : _state(new State())
+{
+    nThreads = std::max(1u, nThreads);
+    _state->uris = uris;
+    _state->options = options;
+    _state->depth = depth > 0 ? depth : 2 * nThreads;
+
+    // next - delivered counts the files being loaded or loaded but not yet
+    // handed out, so that bounding it by depth bounds the reordering buffer
+    State& state = *_state;
+    auto worker = [&state]() {
+        const size_t nFiles = state.uris.size();
+        while (true) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.workerCondition.wait(lock, [&state, nFiles]() {
+                    return state.cancelled || state.next >= nFiles ||
+                           state.next - state.delivered < state.depth;
+                });
+                if (state.cancelled || state.next >= nFiles)
+                    return;
+                index = state.next++;
+            }
+
+            LoadResult result{index, state.uris[index], nullptr, ""};
+            try {
+                result.morphology = std::make_shared<Morphology>(state.uris[index], state.options);
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            } catch (...) {
+                result.error = "Unknown error while loading " + state.uris[index];
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.ready.emplace(index, std::move(result));
+            }
+            state.resultCondition.notify_all();
+        }
+    };
+
+    try {
+        const size_t nWorkers = std::min(static_cast<size_t>(nThreads), uris.size());
+        for (size_t i = 0; i < nWorkers; ++i)
+            _threads.emplace_back(worker);
+    } catch (...) {
+        cancel();
+        for (auto& thread : _threads)
+            thread.join();
+        throw;
+    }
+}
+
+Prefetcher::~Prefetcher()
+{
+    cancel();
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+bool Prefetcher::next(LoadResult& result)
+{
+    State& state = *_state;
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.resultCondition.wait(lock, [&state]() {
+            return state.cancelled || state.delivered >= state.uris.size() ||
+                   state.ready.count(state.delivered) > 0;
+        });
+        if (state.cancelled || state.delivered >= state.uris.size())
+            return false;
+
+        const auto it = state.ready.find(state.delivered);
+        result = std::move(it->second);
+        state.ready.erase(it);
+        ++state.delivered;
+    }
+    state.workerCondition.notify_one();
+    return true;
+}
+
+void Prefetcher::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->cancelled = true;
+        _state->ready.clear();
+    }
+    _state->workerCondition.notify_all();
+    _state->resultCondition.notify_all();
+}
+
+size_t Prefetcher::size() const
+{
+    return _state->uris.size();
+}
+
+size_t Prefetcher::depth() const
+{
+    return _state->depth;
+}
+} // namespace morphio
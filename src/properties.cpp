@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <cmath>
+#include <memory>    // std::align
+#include <utility>   // std::move
 
 #include <morphio/errorMessages.h>
 #include <morphio/properties.h>
@@ -13,9 +15,9 @@ namespace Property {
 PointLevel::PointLevel(std::vector<Point::Type> points,
     std::vector<Diameter::Type> diameters,
     std::vector<Perimeter::Type> perimeters)
-    : _points(points)
-    , _diameters(diameters)
-    , _perimeters(perimeters)
+    : _points(std::move(points))
+    , _diameters(std::move(diameters))
+    , _perimeters(std::move(perimeters))
 {
     if (_points.size() != _diameters.size())
         throw SectionBuilderError(
@@ -153,16 +155,15 @@ bool compare(const morphio::range<const morphio::Point>& vec1,
     return true;
 }
 
-template <typename T, typename U>
-bool compare(const std::map<T, U>& vec1, const std::map<T, U>& vec2,
+bool compare(const Children& children1, const Children& children2,
     const std::string& name, LogLevel logLevel)
 {
-    if (vec1 == vec2)
+    if (children1 == children2)
         return true;
     if (logLevel > LogLevel::ERROR) {
-        if (vec1.size() != vec2.size()) {
+        if (children1._ids.size() != children2._ids.size()) {
             LBERROR(Warning::UNDEFINED,
-                "Error comparing " + name + ", size differs: " + std::to_string(vec1.size()) + " vs " + std::to_string(vec2.size()));
+                "Error comparing " + name + ", size differs: " + std::to_string(children1._ids.size()) + " vs " + std::to_string(children2._ids.size()));
         }
     }
 
@@ -180,6 +181,212 @@ bool compare(const T& el1, const T& el2, const std::string& name, LogLevel logLe
     return false;
 }
 
+namespace {
+// The sections reachable from starts, in depth first order, each section
+// being followed by the subtrees of its children in increasing id order.
+// A section is visited once, should broken data make a cycle.
+std::vector<uint32_t> _depthFirstOrder(const Children& children,
+    const std::vector<uint32_t>& starts,
+    size_t nSections)
+{
+    std::vector<uint32_t> order;
+    std::vector<bool> visited(nSections, false);
+    std::vector<uint32_t> stack(starts.rbegin(), starts.rend());
+    while (!stack.empty()) {
+        const uint32_t id = stack.back();
+        stack.pop_back();
+        if (visited[id])
+            continue;
+        visited[id] = true;
+        order.push_back(id);
+        const auto ids = children.children(id);
+        for (size_t i = ids.size(); i > 0; --i)
+            stack.push_back(ids[i - 1]);
+    }
+    return order;
+}
+
+// The sections reachable from starts, in breadth first order
+std::vector<uint32_t> _breadthFirstOrder(const Children& children,
+    const std::vector<uint32_t>& starts,
+    size_t nSections)
+{
+    std::vector<uint32_t> order(starts);
+    std::vector<bool> visited(nSections, false);
+    for (const uint32_t id : order)
+        visited[id] = true;
+    for (size_t i = 0; i < order.size(); ++i)
+        for (const uint32_t child : children.children(order[i]))
+            if (!visited[child]) {
+                visited[child] = true;
+                order.push_back(child);
+            }
+    return order;
+}
+} // namespace
+
+Children::Children(const std::vector<Section::Type>& sections)
+    : _offsets(sections.size() + 1, 0)
+{
+    const size_t nSections = sections.size();
+    const auto parentOf = [&sections, nSections](size_t id) {
+        const int32_t parent = sections[id][1];
+        return parent >= 0 && static_cast<size_t>(parent) < nSections ? static_cast<size_t>(parent)
+                                                                      : nSections;
+    };
+
+    // Count the children of each section, then place them in increasing id
+    // order from the first slot of their parent
+    for (size_t id = 0; id < nSections; ++id) {
+        const size_t parent = parentOf(id);
+        if (parent < nSections)
+            ++_offsets[parent + 1];
+        else if (sections[id][1] == -1)
+            _roots.push_back(static_cast<uint32_t>(id));
+    }
+    for (size_t id = 0; id < nSections; ++id)
+        _offsets[id + 1] += _offsets[id];
+
+    _ids.resize(_offsets.back());
+    std::vector<uint32_t> cursors(_offsets.begin(), _offsets.end() - 1);
+    for (size_t id = 0; id < nSections; ++id) {
+        const size_t parent = parentOf(id);
+        if (parent < nSections)
+            _ids[cursors[parent]++] = static_cast<uint32_t>(id);
+    }
+
+    _depthFirst = _depthFirstOrder(*this, _roots, nSections);
+    _breadthFirst = _breadthFirstOrder(*this, _roots, nSections);
+
+    // In depth first order, the subtree of a section ends with the subtree
+    // of its last child
+    const auto unreachable = static_cast<uint32_t>(_depthFirst.size());
+    _depthPositions.assign(nSections, unreachable);
+    _subtreeEnds.assign(nSections, unreachable);
+    for (size_t position = _depthFirst.size(); position > 0; --position) {
+        const uint32_t id = _depthFirst[position - 1];
+        const auto ids = children(id);
+        _depthPositions[id] = static_cast<uint32_t>(position - 1);
+        _subtreeEnds[id] = ids.empty() ? static_cast<uint32_t>(position)
+                                       : _subtreeEnds[ids[ids.size() - 1]];
+    }
+}
+
+range<const uint32_t> Children::children(uint32_t sectionId) const
+{
+    if (static_cast<size_t>(sectionId) + 1 >= _offsets.size())
+        return range<const uint32_t>();
+    return range<const uint32_t>(_ids.data() + _offsets[sectionId],
+        _ids.data() + _offsets[sectionId + 1]);
+}
+
+range<const uint32_t> Children::roots() const
+{
+    return range<const uint32_t>(_roots.data(), _roots.data() + _roots.size());
+}
+
+range<const uint32_t> Children::depthFirst() const
+{
+    return range<const uint32_t>(_depthFirst.data(), _depthFirst.data() + _depthFirst.size());
+}
+
+range<const uint32_t> Children::breadthFirst() const
+{
+    return range<const uint32_t>(_breadthFirst.data(), _breadthFirst.data() + _breadthFirst.size());
+}
+
+range<const uint32_t> Children::subtree(uint32_t sectionId) const
+{
+    if (sectionId >= _depthPositions.size() || _depthPositions[sectionId] == _depthFirst.size())
+        return range<const uint32_t>();
+    return range<const uint32_t>(_depthFirst.data() + _depthPositions[sectionId],
+        _depthFirst.data() + _subtreeEnds[sectionId]);
+}
+
+std::vector<uint32_t> Children::depthFirst(uint32_t sectionId) const
+{
+    if (sectionId >= _depthPositions.size())
+        return std::vector<uint32_t>();
+    const auto view = subtree(sectionId);
+    if (!view.empty())
+        return std::vector<uint32_t>(view.begin(), view.end());
+    return _depthFirstOrder(*this, {sectionId}, _depthPositions.size());
+}
+
+std::vector<uint32_t> Children::breadthFirst(uint32_t sectionId) const
+{
+    if (sectionId >= _depthPositions.size())
+        return std::vector<uint32_t>();
+    return _breadthFirstOrder(*this, {sectionId}, _depthPositions.size());
+}
+
+bool Children::operator==(const Children& other) const
+{
+    return this == &other || (_offsets == other._offsets && _ids == other._ids && _roots == other._roots);
+}
+
+bool Children::operator!=(const Children& other) const
+{
+    return !(*this == other);
+}
+
+const size_t PointColumns::alignment;
+
+PointColumns::PointColumns(const std::vector<Point::Type>& points)
+    : _data(nullptr)
+    , _size(points.size())
+{
+    const size_t lanes = alignment / sizeof(float);
+    _stride = (_size + lanes - 1) / lanes * lanes;
+
+    // Zero initialized, with the room to move the start to the alignment
+    size_t space = (3 * _stride + lanes) * sizeof(float);
+    _buffer.reset(new float[3 * _stride + lanes]());
+    void* start = _buffer.get();
+    _data = static_cast<float*>(std::align(alignment, 3 * _stride * sizeof(float), start, space));
+
+    float* x = _data;
+    float* y = _data + _stride;
+    float* z = _data + 2 * _stride;
+    for (size_t i = 0; i < _size; ++i) {
+        x[i] = points[i][0];
+        y[i] = points[i][1];
+        z[i] = points[i][2];
+    }
+}
+
+size_t PointColumns::memoryUsage(size_t size)
+{
+    const size_t lanes = alignment / sizeof(float);
+    const size_t stride = (size + lanes - 1) / lanes * lanes;
+    return sizeof(PointColumns) + (3 * stride + lanes) * sizeof(float);
+}
+
+range<const float> PointColumns::column(size_t axis) const
+{
+    if (axis > 2)
+        throw RawDataError("PointColumns::column: axis must be 0, 1 or 2, got " + std::to_string(axis));
+    const float* begin = _data + axis * _stride;
+    return range<const float>(begin, begin + _size);
+}
+
+PointColumnsCache& PointColumnsCache::operator=(const PointColumnsCache& other)
+{
+    if (this != &other) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _columns.reset();
+    }
+    return *this;
+}
+
+const PointColumns& PointColumnsCache::get(const std::vector<Point::Type>& points) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_columns)
+        _columns.reset(new PointColumns(points));
+    return *_columns;
+}
+
 bool SectionLevel::diff(const SectionLevel& other, LogLevel logLevel) const
 {
     return !(this == &other ||
@@ -232,9 +439,9 @@ MitochondriaPointLevel::MitochondriaPointLevel(
     std::vector<MitoNeuriteSectionId::Type> sectionIds,
     std::vector<MitoPathLength::Type> relativePathLengths,
     std::vector<MitoDiameter::Type> diameters)
-    : _sectionIds(sectionIds)
-    , _relativePathLengths(relativePathLengths)
-    , _diameters(diameters)
+    : _sectionIds(std::move(sectionIds))
+    , _relativePathLengths(std::move(relativePathLengths))
+    , _diameters(std::move(diameters))
 {
     if (_sectionIds.size() != _relativePathLengths.size())
         throw SectionBuilderError(
@@ -332,16 +539,43 @@ const std::vector<MitoNeuriteSectionId::Type>&
     return _mitochondriaPointLevel._sectionIds;
 }
 
+PointLevelLoader::~PointLevelLoader()
+{
+}
+
 template <>
 std::vector<Point::Type>& Properties::get<Point>()
 {
+    if (_pointLoader)
+        return _pointLoader->load(0, _pointLoader->size())._points;
     return _pointLevel._points;
 }
 template <>
 const std::vector<Point::Type>& Properties::get<Point>() const
 {
+    if (_pointLoader)
+        return _pointLoader->load(0, _pointLoader->size())._points;
+    return _pointLevel._points;
+}
+template <>
+const std::vector<Point::Type>& Properties::get<Point>(SectionRange range) const
+{
+    if (_pointLoader)
+        return _pointLoader->load(range.first, range.second)._points;
     return _pointLevel._points;
 }
+template <>
+size_t Properties::size<Point>() const
+{
+    if (_pointLoader)
+        return _pointLoader->size();
+    return _pointLevel._points.size();
+}
+
+const PointColumns& Properties::pointColumns() const
+{
+    return _pointColumns.get(get<Point>());
+}
 
 template <>
 std::vector<SectionType::Type>& Properties::get<SectionType>()
@@ -357,27 +591,59 @@ const std::vector<SectionType::Type>& Properties::get<SectionType>() const
 template <>
 std::vector<Perimeter::Type>& Properties::get<Perimeter>()
 {
+    if (_pointLoader)
+        return _pointLoader->load(0, _pointLoader->size())._perimeters;
     return _pointLevel._perimeters;
 }
 
 template <>
 const std::vector<Perimeter::Type>& Properties::get<Perimeter>() const
 {
+    if (_pointLoader)
+        return _pointLoader->load(0, _pointLoader->size())._perimeters;
+    return _pointLevel._perimeters;
+}
+
+template <>
+const std::vector<Perimeter::Type>& Properties::get<Perimeter>(SectionRange range) const
+{
+    if (_pointLoader)
+        return _pointLoader->load(range.first, range.second)._perimeters;
     return _pointLevel._perimeters;
 }
 
 template <>
 std::vector<Diameter::Type>& Properties::get<Diameter>()
 {
+    if (_pointLoader)
+        return _pointLoader->load(0, _pointLoader->size())._diameters;
     return _pointLevel._diameters;
 }
 
 template <>
 const std::vector<Diameter::Type>& Properties::get<Diameter>() const
 {
+    if (_pointLoader)
+        return _pointLoader->load(0, _pointLoader->size())._diameters;
+    return _pointLevel._diameters;
+}
+
+template <>
+const std::vector<Diameter::Type>& Properties::get<Diameter>(SectionRange range) const
+{
+    if (_pointLoader)
+        return _pointLoader->load(range.first, range.second)._diameters;
     return _pointLevel._diameters;
 }
 
+template <>
+size_t Properties::size<Diameter>() const
+{
+    if (_pointLoader)
+        return _pointLoader->size();
+    return _pointLevel._diameters.size();
+}
+
 template <>
 std::vector<MitoDiameter::Type>& Properties::get<MitoDiameter>()
 {
@@ -403,14 +669,13 @@ const std::vector<MitoPathLength::Type>& Properties::get<MitoPathLength>() const
 }
 
 template <>
-const std::map<int32_t, std::vector<uint32_t>>& Properties::children<Section>()
+const Children& Properties::children<Section>() const
 {
     return _sectionLevel._children;
 }
 
 template <>
-const std::map<int32_t, std::vector<uint32_t>>&
-    Properties::children<MitoSection>()
+const Children& Properties::children<MitoSection>() const
 {
     return _mitochondriaSectionLevel._children;
 }
@@ -0,0 +1,316 @@
+#include "propertiesCache.h"
+
+#include <atomic>        // std::atomic
+#include <cstdlib>       // realpath / free
+#include <functional>    // std::hash
+#include <list>          // std::list
+#include <mutex>         // std::mutex
+#include <sys/stat.h>    // stat
+#include <unordered_map> // std::unordered_map
+
+/**
+   The cache is split in _nShards independent LRU lists, each one with its
+   own lock and 1/_nShards of the memory budget, so that concurrent lookups
+   of different files rarely contend. A file always lands in the same shard
+   (the shard is chosen from the path only) so that invalidating a file only
+   touches one shard.
+
+   A shard may go over its share of the budget to hold a single entry larger
+   than it (up to the whole budget), the entries of the other shards are then
+   evicted to stay within the budget.
+
+   An entry is charged the memory it holds once fully used: the points of a
+   LAZY_LOAD morphology and the point columns are counted at insertion even
+   though they are only allocated on first access.
+
+   Only the latest version of a file (for given options) is cached: the
+   index is keyed by path, options and section types, the modification time
+   and size of the entry being compared on lookup.
+**/
+
+namespace morphio {
+namespace cache {
+namespace {
+const size_t _nShards = 16;
+
+std::atomic<size_t> _capacity(0);
+std::atomic<size_t> _bytes(0);
+std::atomic<size_t> _hits(0);
+std::atomic<size_t> _misses(0);
+std::atomic<size_t> _evictions(0);
+
+// Hash and equality ignoring the file version (mtime and size)
+struct KeyHash
+{
+    size_t operator()(const Key& key) const
+    {
+        size_t seed = std::hash<std::string>()(key.path);
+        for (SectionType type : key.sectionTypes)
+            seed ^= static_cast<size_t>(type) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= static_cast<size_t>(key.options) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+struct KeyEqual
+{
+    bool operator()(const Key& left, const Key& right) const
+    {
+        return left.path == right.path && left.options == right.options &&
+               left.sectionTypes == right.sectionTypes;
+    }
+};
+
+bool _sameVersion(const Key& left, const Key& right)
+{
+    return left.mtime == right.mtime && left.size == right.size;
+}
+
+struct Entry
+{
+    Key key;
+    std::shared_ptr<Property::Properties> properties;
+    size_t bytes;
+};
+
+struct Shard
+{
+    std::mutex mutex;
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash, KeyEqual> index;
+    size_t bytes = 0;
+};
+
+Shard* _shards()
+{
+    static Shard shards[_nShards];
+    return shards;
+}
+
+Shard& _shard(const std::string& path)
+{
+    return _shards()[std::hash<std::string>()(path) % _nShards];
+}
+
+size_t _shardCapacity()
+{
+    return _capacity / _nShards;
+}
+
+// Must be called with the shard locked
+std::list<Entry>::iterator _erase(Shard& shard, std::list<Entry>::iterator it)
+{
+    _bytes -= it->bytes;
+    shard.bytes -= it->bytes;
+    shard.index.erase(it->key);
+    return shard.entries.erase(it);
+}
+
+// Must be called with the shard locked. The most recently used entry is
+// kept if it fits in the whole budget.
+void _shrink(Shard& shard, size_t capacity)
+{
+    while (shard.bytes > capacity && (shard.entries.size() > 1 || shard.bytes > _capacity)) {
+        _erase(shard, std::prev(shard.entries.end()));
+        ++_evictions;
+    }
+}
+
+// Evict the least recently used entries of the shards other than current,
+// one per shard in turn, until the whole budget is met. Must be called with
+// no shard locked.
+void _shrinkOthers(const Shard* current)
+{
+    bool evicted = true;
+    while (_bytes > _capacity && evicted) {
+        evicted = false;
+        for (size_t i = 0; i < _nShards && _bytes > _capacity; ++i) {
+            Shard& shard = _shards()[i];
+            if (&shard == current)
+                continue;
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (!shard.entries.empty()) {
+                _erase(shard, std::prev(shard.entries.end()));
+                ++_evictions;
+                evicted = true;
+            }
+        }
+    }
+}
+
+template <typename T>
+size_t _memoryUsage(const std::vector<T>& data)
+{
+    return data.capacity() * sizeof(T);
+}
+
+size_t _memoryUsage(const Property::Children& children)
+{
+    return _memoryUsage(children._offsets) + _memoryUsage(children._ids) +
+           _memoryUsage(children._roots) + _memoryUsage(children._depthFirst) +
+           _memoryUsage(children._breadthFirst) + _memoryUsage(children._depthPositions) +
+           _memoryUsage(children._subtreeEnds);
+}
+
+size_t _memoryUsage(const Property::PointLevel& pointLevel)
+{
+    return _memoryUsage(pointLevel._points) + _memoryUsage(pointLevel._diameters) +
+           _memoryUsage(pointLevel._perimeters);
+}
+
+size_t _memoryUsage(const Property::Properties& properties)
+{
+    size_t bytes = sizeof(Property::Properties) + _memoryUsage(properties._pointLevel) +
+                   _memoryUsage(properties._somaLevel) +
+                   _memoryUsage(properties._sectionLevel._sections) +
+                   _memoryUsage(properties._sectionLevel._sectionTypes) +
+                   _memoryUsage(properties._sectionLevel._children) +
+                   _memoryUsage(properties._mitochondriaPointLevel._sectionIds) +
+                   _memoryUsage(properties._mitochondriaPointLevel._relativePathLengths) +
+                   _memoryUsage(properties._mitochondriaPointLevel._diameters) +
+                   _memoryUsage(properties._mitochondriaSectionLevel._sections) +
+                   _memoryUsage(properties._mitochondriaSectionLevel._children) +
+                   _memoryUsage(properties._annotations);
+    for (const auto& annotation : properties._annotations)
+        bytes += _memoryUsage(annotation._points) + annotation._details.capacity();
+
+    // The lazily loaded points and the point columns are allocated after the
+    // insertion, so they are charged upfront for their full size
+    if (properties._pointLoader)
+        bytes += properties._pointLoader->memoryUsage();
+    bytes += Property::PointColumns::memoryUsage(properties.size<Property::Point>());
+    return bytes;
+}
+
+std::string _canonicalPath(const URI& uri)
+{
+    char* resolved = realpath(uri.c_str(), nullptr);
+    if (resolved == nullptr)
+        return uri;
+    const std::string path(resolved);
+    free(resolved);
+    return path;
+}
+
+template <typename Function>
+void _forEachShard(Function function)
+{
+    for (size_t i = 0; i < _nShards; ++i) {
+        Shard& shard = _shards()[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        function(shard);
+    }
+}
+} // namespace
+
+bool makeKey(const URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes,
+    Key& key)
+{
+    if (_capacity == 0)
+        return false;
+
+    struct stat info;
+    if (stat(uri.c_str(), &info) != 0)
+        return false;
+
+    key.path = _canonicalPath(uri);
+    key.options = options;
+    key.sectionTypes = sectionTypes;
+#ifdef __APPLE__
+    const struct timespec& mtime = info.st_mtimespec;
+#else
+    const struct timespec& mtime = info.st_mtim;
+#endif
+    const int64_t seconds = mtime.tv_sec;
+    key.mtime = seconds * 1000000000 + mtime.tv_nsec;
+    key.size = info.st_size;
+    return true;
+}
+
+std::shared_ptr<Property::Properties> find(const Key& key)
+{
+    Shard& shard = _shard(key.path);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto it = shard.index.find(key);
+    if (it == shard.index.end() || !_sameVersion(it->second->key, key)) {
+        ++_misses;
+        return nullptr;
+    }
+
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    ++_hits;
+    return it->second->properties;
+}
+
+void insert(const Key& key, std::shared_ptr<Property::Properties> properties)
+{
+    const size_t bytes = _memoryUsage(*properties);
+    if (bytes > _capacity)
+        return;
+
+    Shard& shard = _shard(key.path);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // Drop the entry of a previous version of the file, or the one
+        // inserted by a concurrent load of the same file
+        const auto it = shard.index.find(key);
+        if (it != shard.index.end())
+            _erase(shard, it->second);
+
+        shard.entries.push_front(Entry{key, properties, bytes});
+        shard.index[key] = shard.entries.begin();
+        shard.bytes += bytes;
+        _bytes += bytes;
+        _shrink(shard, _shardCapacity());
+    }
+    _shrinkOthers(&shard);
+}
+} // namespace cache
+
+void set_cache_capacity(size_t bytes)
+{
+    cache::_capacity = bytes;
+    const size_t capacity = cache::_shardCapacity();
+    cache::_forEachShard([capacity](cache::Shard& shard) { cache::_shrink(shard, capacity); });
+    cache::_shrinkOthers(nullptr);
+}
+
+size_t cache_capacity()
+{
+    return cache::_capacity;
+}
+
+CacheStatistics cache_statistics()
+{
+    size_t entries = 0;
+    cache::_forEachShard([&entries](cache::Shard& shard) { entries += shard.entries.size(); });
+    return CacheStatistics{cache::_hits, cache::_misses, cache::_evictions, entries, cache::_bytes};
+}
+
+void invalidate_cache(const URI& uri)
+{
+    const std::string path = cache::_canonicalPath(uri);
+    cache::Shard& shard = cache::_shard(path);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+        if (it->key.path == path)
+            it = cache::_erase(shard, it);
+        else
+            ++it;
+    }
+}
+
+void clear_cache()
+{
+    cache::_forEachShard([](cache::Shard& shard) {
+        while (!shard.entries.empty())
+            cache::_erase(shard, shard.entries.begin());
+    });
+    cache::_hits = 0;
+    cache::_misses = 0;
+    cache::_evictions = 0;
+}
+} // namespace morphio
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint> // int64_t
+#include <memory>  // std::shared_ptr
+#include <set>     // std::set
+#include <string>  // std::string
+
+#include <morphio/cache.h>
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace cache {
+struct Key
+{
+    std::string path;
+    unsigned int options;
+    std::set<SectionType> sectionTypes;
+    int64_t mtime; // in nanoseconds
+    int64_t size;
+};
+
+/**
+   Fill the cache key of the given file
+
+   Return false if the cache is disabled or if the file can not be stat-ed,
+   in which case the file is loaded without the cache.
+**/
+bool makeKey(const URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes,
+    Key& key);
+
+/**
+   Return the cached Properties or nullptr on a miss
+**/
+std::shared_ptr<Property::Properties> find(const Key& key);
+
+void insert(const Key& key, std::shared_ptr<Property::Properties> properties);
+} // namespace cache
+} // namespace morphio
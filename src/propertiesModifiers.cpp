@@ -0,0 +1,329 @@
+#include "propertiesModifiers.h"
+
+#include <algorithm> // std::sort
+#include <cmath>     // sqrtf, powf
+#include <limits>    // std::numeric_limits
+#include <utility>   // std::pair
+
+#include <morphio/errorMessages.h>
+
+/**
+   Sections are handled by index and the points are copied once, at the end,
+   in the new order.
+
+   A section which is the only child of its parent is merged into it, as done
+   by mut::Morphology::sanitize. The section which remains is the head of a
+   chain of the original sections whose points are concatenated.
+**/
+
+namespace morphio {
+namespace modifiers {
+namespace {
+using Run = std::pair<size_t, size_t>; // [begin, end) of the points of a section
+
+const size_t _noPoint = std::numeric_limits<size_t>::max();
+const int32_t _noSection = -1;
+
+class Tree
+{
+public:
+    Tree(const std::vector<Property::Section::Type>& sections, size_t nPoints)
+        : runs(sections.size())
+        , heads(sections.size())
+        , tails(sections.size())
+        , next(sections.size(), _noSection)
+        , _childOffsets(sections.size() + 1, 0)
+        , _children(sections.size())
+    {
+        const size_t nSections = sections.size();
+        // Like Property::Children, the sections whose parent does not exist
+        // are nobody's children: they are left out of the traversals
+        const auto validParent = [&sections, nSections](size_t id) {
+            const int32_t parent = sections[id][1];
+            return parent >= 0 && static_cast<size_t>(parent) < nSections;
+        };
+        for (size_t i = 0; i < nSections; ++i) {
+            runs[i].first = static_cast<size_t>(sections[i][0]);
+            runs[i].second = i + 1 < nSections ? static_cast<size_t>(sections[i + 1][0])
+                                               : nPoints;
+            heads[i] = tails[i] = static_cast<uint32_t>(i);
+
+            if (sections[i][1] == _noSection)
+                roots.push_back(static_cast<uint32_t>(i));
+            else if (validParent(i))
+                ++_childOffsets[static_cast<size_t>(sections[i][1]) + 1];
+        }
+
+        // Children are stored in increasing id order, like buildChildren does
+        for (size_t i = 0; i < nSections; ++i)
+            _childOffsets[i + 1] += _childOffsets[i];
+        std::vector<size_t> cursors(_childOffsets.begin(), _childOffsets.end() - 1);
+        for (size_t i = 0; i < nSections; ++i)
+            if (validParent(i))
+                _children[cursors[static_cast<size_t>(sections[i][1])]++] = static_cast<uint32_t>(i);
+    }
+
+    size_t nChildren(uint32_t id) const
+    {
+        return _childOffsets[id + 1] - _childOffsets[id];
+    }
+
+    // Call function on the children of id in reverse order
+    template <typename Function>
+    void forEachChildReversed(uint32_t id, Function function) const
+    {
+        for (size_t i = _childOffsets[id + 1]; i > _childOffsets[id]; --i)
+            function(_children[i - 1]);
+    }
+
+    std::vector<Run> runs;
+    std::vector<uint32_t> heads; // the section each section is merged in
+    std::vector<uint32_t> tails; // the last section merged in a head
+    std::vector<int32_t> next;   // the next section of a chain
+    std::vector<uint32_t> roots;
+
+private:
+    std::vector<size_t> _childOffsets;
+    std::vector<uint32_t> _children;
+};
+
+Property::PointLevel _pointLevel(const Property::PointLevel& from, const Run& run)
+{
+    Property::PointLevel pointLevel;
+    const auto begin = static_cast<std::ptrdiff_t>(run.first);
+    const auto end = static_cast<std::ptrdiff_t>(run.second);
+    pointLevel._points.assign(from._points.begin() + begin, from._points.begin() + end);
+    pointLevel._diameters.assign(from._diameters.begin() + begin, from._diameters.begin() + end);
+    if (!from._perimeters.empty())
+        pointLevel._perimeters.assign(from._perimeters.begin() + begin,
+            from._perimeters.begin() + end);
+    return pointLevel;
+}
+
+/**
+   Merge the unifurcations, see mut::Morphology::sanitize
+
+   Return true if any section has been merged
+**/
+bool _sanitize(Property::Properties& properties, Tree& tree)
+{
+    const auto& pointLevel = properties._pointLevel;
+    const readers::DebugInfo debugInfo;
+    const readers::ErrorMessages err(debugInfo._filename);
+
+    // Index of the last point of each head
+    std::vector<size_t> lastPoints(tree.runs.size(), _noPoint);
+    // The ids that the sections would have in a mut::Morphology, used in
+    // warnings and annotations
+    std::vector<uint32_t> mutIds(tree.runs.size());
+
+    bool merged = false;
+    uint32_t counter = 0;
+    std::vector<std::pair<uint32_t, int32_t>> stack; // (section, original parent)
+    for (auto it = tree.roots.rbegin(); it != tree.roots.rend(); ++it)
+        stack.emplace_back(*it, _noSection);
+
+    while (!stack.empty()) {
+        const uint32_t id = stack.back().first;
+        const int32_t parent = stack.back().second;
+        stack.pop_back();
+        tree.forEachChildReversed(id, [&stack, id](uint32_t child) {
+            stack.emplace_back(child, static_cast<int32_t>(id));
+        });
+
+        mutIds[id] = counter++;
+        Run& run = tree.runs[id];
+        const bool empty = run.first == run.second;
+        if (parent == _noSection) {
+            lastPoints[id] = empty ? _noPoint : run.second - 1;
+            continue;
+        }
+
+        const uint32_t head = tree.heads[static_cast<size_t>(parent)];
+        const size_t lastPoint = lastPoints[head];
+        const bool duplicate = lastPoint == _noPoint ||
+                               (!empty && pointLevel._points[lastPoint] == pointLevel._points[run.first]);
+
+        if (!readers::ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE) && !duplicate) {
+            Property::PointLevel parentPoints;
+            if (lastPoint != _noPoint)
+                parentPoints = _pointLevel(pointLevel, {lastPoint, lastPoint + 1});
+            LBERROR(Warning::WRONG_DUPLICATE,
+                err.WARNING_WRONG_DUPLICATE(mutIds[id], mutIds[head],
+                    _pointLevel(pointLevel, run), parentPoints));
+        }
+
+        if (tree.nChildren(static_cast<uint32_t>(parent)) != 1) {
+            lastPoints[id] = empty ? _noPoint : run.second - 1;
+            continue;
+        }
+
+        LBERROR(Warning::ONLY_CHILD,
+            err.WARNING_ONLY_CHILD(debugInfo, mutIds[head], mutIds[id]));
+        properties._annotations.emplace_back(AnnotationType::SINGLE_CHILD, mutIds[id],
+            _pointLevel(pointLevel, run), "", debugInfo.getLineNumber(mutIds[head]));
+
+        if (duplicate && !empty)
+            ++run.first;
+        if (run.first != run.second)
+            lastPoints[head] = run.second - 1;
+
+        tree.next[tree.tails[head]] = static_cast<int32_t>(id);
+        tree.tails[head] = id;
+        tree.heads[id] = head;
+        merged = true;
+    }
+    return merged;
+}
+
+void _somaSphere(Property::PointLevel& soma)
+{
+    float size = static_cast<float>(soma._points.size());
+
+    if (size < 2)
+        return;
+
+    float x = 0, y = 0, z = 0, r = 0;
+    for (const Point& point : soma._points) {
+        x += point[0] / size;
+        y += point[1] / size;
+        z += point[2] / size;
+    }
+
+    for (const Point& point : soma._points) {
+        r += sqrtf(powf(point[0] - x, 2) +
+                   powf(point[1] - y, 2) +
+                   powf(point[2] - z, 2)) /
+             size;
+    }
+
+    soma._points = {{x, y, z}};
+    soma._diameters = {r};
+}
+
+/**
+   Gather the non empty runs of points of a head section and apply the
+   NO_DUPLICATES and TWO_POINTS_SECTIONS modifiers on them
+**/
+void _sectionRuns(const Tree& tree,
+    uint32_t head,
+    bool root,
+    unsigned int modifiers,
+    std::vector<Run>& runs)
+{
+    runs.clear();
+    size_t size = 0;
+    for (int32_t id = static_cast<int32_t>(head); id != _noSection;
+         id = tree.next[static_cast<size_t>(id)]) {
+        const Run& run = tree.runs[static_cast<size_t>(id)];
+        if (run.first != run.second) {
+            runs.push_back(run);
+            size += run.second - run.first;
+        }
+    }
+
+    if ((modifiers & NO_DUPLICATES) && !root && size >= 1) {
+        if (++runs.front().first == runs.front().second)
+            runs.erase(runs.begin());
+        --size;
+    }
+
+    if ((modifiers & TWO_POINTS_SECTIONS) && size >= 2) {
+        const size_t first = runs.front().first;
+        const size_t last = runs.back().second - 1;
+        runs = {{first, first + 1}, {last, last + 1}};
+    }
+}
+
+template <typename T>
+void _append(std::vector<T>& to, const std::vector<T>& from, const Run& run)
+{
+    to.insert(to.end(), from.begin() + static_cast<std::ptrdiff_t>(run.first),
+        from.begin() + static_cast<std::ptrdiff_t>(run.second));
+}
+} // namespace
+
+void apply(Property::Properties& properties, unsigned int modifiers)
+{
+    if (properties._pointLoader) {
+        properties._pointLevel = properties._pointLoader->load(0, properties._pointLoader->size());
+        properties._pointLoader.reset();
+    }
+
+    if (modifiers & SOMA_SPHERE)
+        _somaSphere(properties._somaLevel);
+
+    auto& sections = properties._sectionLevel._sections;
+    auto& types = properties._sectionLevel._sectionTypes;
+    const auto& pointLevel = properties._pointLevel;
+
+    Tree tree(sections, pointLevel._points.size());
+    const bool merged = _sanitize(properties, tree);
+
+    std::vector<uint32_t> roots = tree.roots;
+    if (modifiers & NRN_ORDER)
+        std::sort(roots.begin(), roots.end(), [&types](uint32_t a, uint32_t b) {
+            return types[a] < types[b];
+        });
+
+    // Depth first order of the remaining sections, the children of a head
+    // are the ones of the last section merged in it
+    std::vector<uint32_t> order;
+    order.reserve(sections.size());
+    std::vector<uint32_t> stack(roots.rbegin(), roots.rend());
+    while (!stack.empty()) {
+        const uint32_t id = stack.back();
+        stack.pop_back();
+        order.push_back(id);
+        tree.forEachChildReversed(tree.tails[id], [&stack](uint32_t child) {
+            stack.push_back(child);
+        });
+    }
+
+    bool reordered = false;
+    for (size_t i = 0; i < order.size() && !reordered; ++i)
+        reordered = order[i] != i;
+    if (!merged && !reordered && !(modifiers & (NO_DUPLICATES | TWO_POINTS_SECTIONS)))
+        return;
+
+    std::vector<int32_t> newIds(sections.size(), _noSection);
+    for (size_t i = 0; i < order.size(); ++i)
+        newIds[order[i]] = static_cast<int32_t>(i);
+
+    std::vector<Property::Section::Type> newSections;
+    std::vector<SectionType> newTypes;
+    Property::PointLevel newPointLevel;
+    newSections.reserve(order.size());
+    newTypes.reserve(order.size());
+    newPointLevel._points.reserve(pointLevel._points.size());
+    newPointLevel._diameters.reserve(pointLevel._diameters.size());
+    newPointLevel._perimeters.reserve(pointLevel._perimeters.size());
+
+    std::vector<Run> runs;
+    for (const uint32_t id : order) {
+        const int32_t parent = sections[id][1];
+        const bool root = parent == _noSection;
+        newSections.push_back({static_cast<int>(newPointLevel._points.size()),
+            root ? _noSection : newIds[tree.heads[static_cast<size_t>(parent)]]});
+        newTypes.push_back(types[id]);
+
+        _sectionRuns(tree, id, root, modifiers, runs);
+        for (const Run& run : runs) {
+            _append(newPointLevel._points, pointLevel._points, run);
+            _append(newPointLevel._diameters, pointLevel._diameters, run);
+            if (!pointLevel._perimeters.empty())
+                _append(newPointLevel._perimeters, pointLevel._perimeters, run);
+        }
+    }
+
+    // Mitochondria points on a merged section now belong to its head
+    for (auto& sectionId : properties._mitochondriaPointLevel._sectionIds)
+        if (sectionId < newIds.size() && newIds[tree.heads[sectionId]] != _noSection)
+            sectionId = static_cast<uint32_t>(newIds[tree.heads[sectionId]]);
+
+    sections.swap(newSections);
+    types.swap(newTypes);
+    properties._pointLevel = std::move(newPointLevel);
+}
+} // namespace modifiers
+} // namespace morphio
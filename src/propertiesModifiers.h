@@ -0,0 +1,19 @@
+#pragma once
+
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace modifiers {
+/**
+   Apply the modifier flags directly on the arrays of a loaded morphology
+
+   The result is the one of converting it to a mut::Morphology, calling
+   sanitize() and applyModifiers() and then buildReadOnly(): unifurcations are
+   merged and the sections are renumbered in depth first order, but no
+   per-section object is allocated.
+
+   The children of properties are not updated and must be rebuilt.
+**/
+void apply(Property::Properties& properties, unsigned int modifiers);
+} // namespace modifiers
+} // namespace morphio
@@ -0,0 +1,139 @@
+#include "containerHDF5.h"
+
+#include <morphio/container.h>
+#include <morphio/morphology.h>
+
+#include <highfive/H5Utility.hpp> // HighFive::SilenceHDF5
+
+#include "utilsHDF5.h"
+
+namespace morphio {
+namespace readers {
+namespace h5 {
+ContainerFile::ContainerFile(const URI& uri)
+    : _uri(uri)
+{
+    std::lock_guard<std::recursive_mutex> lock(globalHDF5Mutex());
+    auto error = [&uri](const std::string& reason) {
+        LBTHROW(RawDataError("Reading morphology container '" + uri + "': " + reason));
+    };
+
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> families;
+    std::vector<uint8_t> hasPerimeters;
+    std::vector<size_t> datasetRows(containerOffsetColumns, 0);
+    try {
+        HighFive::SilenceHDF5 silence;
+        _file.reset(new HighFive::File(uri, HighFive::File::ReadOnly));
+
+        const HighFive::Group index = _file->getGroup(containerIndex);
+        index.getDataSet(containerNames).read(_names);
+        index.getDataSet(containerCellFamily).read(families);
+        index.getDataSet(containerHasPerimeters).read(hasPerimeters);
+
+        // The names are written last by ContainerWriter::add(), the other
+        // index datasets have one more row if an add() was interrupted
+        const HighFive::DataSet offsetDataSet = index.getDataSet(containerOffsets);
+        const auto dims = offsetDataSet.getSpace().getDimensions();
+        if (dims.size() != 2 || dims[0] <= _names.size() || dims[1] != containerOffsetColumns)
+            error("bad dimensions of the '" + containerOffsets + "' dataset");
+        offsets.resize(dims[0] * dims[1]);
+        offsetDataSet.read(offsets.data());
+
+        datasetRows[0] = _file->getDataSet("points").getSpace().getDimensions()[0];
+        datasetRows[1] = _file->getDataSet("structure").getSpace().getDimensions()[0];
+        if (offsets[_names.size() * containerOffsetColumns + 2] > 0) {
+            const HighFive::Group mitochondria = _file->getGroup("organelles/mitochondria");
+            datasetRows[2] = mitochondria.getDataSet("points").getSpace().getDimensions()[0];
+            datasetRows[3] = mitochondria.getDataSet("structure").getSpace().getDimensions()[0];
+        }
+    } catch (const HighFive::Exception& exc) {
+        _file.reset();
+        error(exc.what());
+    }
+
+    if (families.size() < _names.size() || hasPerimeters.size() < _names.size())
+        error("the index datasets have fewer rows than the names");
+
+    // The rows of a cell end where the rows of the next one start
+    _cells.resize(_names.size());
+    for (size_t i = 0; i < _names.size(); ++i) {
+        const uint64_t* first = &offsets[i * containerOffsetColumns];
+        const uint64_t* next = first + containerOffsetColumns;
+        for (size_t column = 0; column < containerOffsetColumns; ++column)
+            if (next[column] < first[column] || next[column] > datasetRows[column])
+                error("the rows of cell '" + _names[i] + "' are out of the datasets");
+
+        CellRows& cell = _cells[i];
+        cell.firstPoint = first[0];
+        cell.nPoints = next[0] - first[0];
+        cell.firstSection = first[1];
+        cell.nSections = next[1] - first[1];
+        cell.firstMitoPoint = first[2];
+        cell.nMitoPoints = next[2] - first[2];
+        cell.firstMitoSection = first[3];
+        cell.nMitoSections = next[3] - first[3];
+        cell.family = static_cast<CellFamily>(families[i]);
+        cell.hasPerimeters = hasPerimeters[i] != 0;
+
+        if (!_index.emplace(_names[i], i).second)
+            error("the name '" + _names[i] + "' is used by several cells");
+    }
+}
+
+ContainerFile::~ContainerFile()
+{
+    std::lock_guard<std::recursive_mutex> lock(globalHDF5Mutex());
+    _file.reset();
+}
+
+const std::vector<std::string>& ContainerFile::names() const
+{
+    return _names;
+}
+
+bool ContainerFile::contains(const std::string& name) const
+{
+    return _index.count(name) > 0;
+}
+
+Property::Properties ContainerFile::load(const std::string& name,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes) const
+{
+    const auto it = _index.find(name);
+    if (it == _index.end())
+        LBTHROW(RawDataError("Morphology container '" + _uri + "' has no cell: " + name));
+
+    std::lock_guard<std::recursive_mutex> lock(globalHDF5Mutex());
+    try {
+        HighFive::SilenceHDF5 silence;
+        return MorphologyHDF5(_uri + "/" + name, sectionTypes).load(*_file, _cells[it->second], options);
+    } catch (const HighFive::Exception& exc) {
+        LBTHROW(RawDataError("Reading morphology '" + name + "' of container '" + _uri + "': " +
+                             exc.what()));
+    }
+}
+} // namespace h5
+} // namespace readers
+
+Container::Container(const URI& uri)
+    : _file(std::make_shared<readers::h5::ContainerFile>(uri))
+{
+}
+
+const std::vector<std::string>& Container::names() const
+{
+    return _file->names();
+}
+
+bool Container::contains(const std::string& name) const
+{
+    return _file->contains(name);
+}
+
+size_t Container::size() const
+{
+    return _file->names().size();
+}
+} // namespace morphio
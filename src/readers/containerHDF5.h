@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>        // std::unique_ptr
+#include <set>           // std::set
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+#include "morphologyHDF5.h"
+
+namespace morphio {
+namespace readers {
+namespace h5 {
+// The container layout, see morphio::Container
+const std::string containerIndex("index");
+const std::string containerNames("names");
+const std::string containerOffsets("offsets");
+const std::string containerCellFamily("cell_family");
+const std::string containerHasPerimeters("has_perimeters");
+const size_t containerOffsetColumns = 4;
+
+/**
+   An opened container file and its index of cells
+**/
+class ContainerFile
+{
+public:
+    explicit ContainerFile(const URI& uri);
+    ~ContainerFile();
+
+    ContainerFile(const ContainerFile&) = delete;
+    ContainerFile& operator=(const ContainerFile&) = delete;
+
+    const std::vector<std::string>& names() const;
+    bool contains(const std::string& name) const;
+
+    /**
+       Read the rows of the cell name, throw a RawDataError if there is no
+       such cell
+    **/
+    Property::Properties load(const std::string& name,
+        unsigned int options,
+        const std::set<SectionType>& sectionTypes) const;
+
+private:
+    URI _uri;
+    std::unique_ptr<HighFive::File> _file;
+    std::vector<std::string> _names;
+    std::vector<CellRows> _cells;
+    std::unordered_map<std::string, size_t> _index;
+};
+} // namespace h5
+} // namespace readers
+} // namespace morphio
@@ -0,0 +1,465 @@
+#include "fileBatch.h"
+
+#include <algorithm>  // std::max, std::min
+#include <cerrno>     // errno
+#include <cstdint>    // uint64_t
+#include <cstring>    // std::memset, std::strerror
+#include <fcntl.h>    // open
+#include <memory>     // std::unique_ptr
+#include <sys/stat.h> // fstat, statx
+#include <unistd.h>   // read, close
+
+#ifdef MORPHIO_USE_IO_URING
+#include <linux/io_uring.h> // io_uring_params, io_uring_sqe, io_uring_cqe
+#include <poll.h>           // poll
+#include <sys/mman.h>       // mmap / munmap
+#include <sys/syscall.h>    // __NR_io_uring_setup, __NR_io_uring_enter
+#endif
+
+namespace {
+std::string _error(const morphio::URI& uri, int errnum)
+{
+    return "Could not read file " + uri + ": " + std::strerror(errnum);
+}
+
+void _readFile(const morphio::URI& uri, morphio::readers::FileContent& content)
+{
+    const int fd = open(uri.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        content.error = _error(uri, errno);
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        content.error = _error(uri, errno);
+        close(fd);
+        return;
+    }
+
+    content.data.resize(static_cast<size_t>(info.st_size));
+    size_t done = 0;
+    while (done < content.data.size()) {
+        const ssize_t count = read(fd, &content.data[done], content.data.size() - done);
+        if (count == -1 && errno == EINTR)
+            continue;
+        if (count <= 0) {
+            // A file shrinking while it is read is reported as an I/O error
+            content.error = _error(uri, count == 0 ? EIO : errno);
+            break;
+        }
+        done += static_cast<size_t>(count);
+    }
+    close(fd);
+}
+
+#ifdef MORPHIO_USE_IO_URING
+/**
+   Minimal io_uring submission and completion rings, set up with the raw
+   system calls so that only the kernel headers are needed
+
+   valid() is false if the kernel does not support io_uring or forbids it
+   (seccomp filters of containers often do), the caller then falls back to
+   blocking reads.
+**/
+class Ring
+{
+public:
+    explicit Ring(unsigned entries)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        _fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (_fd < 0)
+            return;
+
+        _sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap)
+            _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+
+        _sq = _map(_sqSize, IORING_OFF_SQ_RING);
+        _cq = singleMap ? _sq : _map(_cqSize, IORING_OFF_CQ_RING);
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = _map(_sqesSize, IORING_OFF_SQES);
+        if (_sq == nullptr || _cq == nullptr || sqes == nullptr) {
+            _release();
+            return;
+        }
+
+        char* sq = static_cast<char*>(_sq);
+        _sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        _sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        _sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        _sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+        _sqEntries = params.sq_entries;
+
+        char* cq = static_cast<char*>(_cq);
+        _cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        _cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        _cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    ~Ring()
+    {
+        _release();
+    }
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    bool valid() const
+    {
+        return _fd >= 0;
+    }
+
+    unsigned entries() const
+    {
+        return _sqEntries;
+    }
+
+    /**
+       Queue a zeroed submission entry, to be filled by the caller, or return
+       nullptr if the ring is full
+    **/
+    io_uring_sqe* queue(uint64_t userData)
+    {
+        const unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        if (_sqLocalTail - head >= _sqEntries)
+            return nullptr;
+        const unsigned index = _sqLocalTail & _sqMask;
+        io_uring_sqe* sqe = &_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->user_data = userData;
+        _sqArray[index] = index;
+        ++_sqLocalTail;
+        ++_pending;
+        return sqe;
+    }
+
+    /**
+       Submit the queued entries and wait for at least one completion
+    **/
+    bool submitAndWait()
+    {
+        __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+        while (true) {
+            const long submitted = syscall(__NR_io_uring_enter, _fd, _pending, 1,
+                IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted >= 0) {
+                _pending -= static_cast<unsigned>(submitted);
+                return true;
+            }
+            if (errno != EINTR)
+                return false;
+        }
+    }
+
+    /**
+       Submit the queued entries without waiting
+    **/
+    void submit()
+    {
+        __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+        long submitted;
+        do
+            submitted = syscall(__NR_io_uring_enter, _fd, _pending, 0, 0, nullptr, 0);
+        while (submitted < 0 && errno == EINTR);
+        if (submitted > 0)
+            _pending -= static_cast<unsigned>(submitted);
+    }
+
+    /**
+       Wait for a completion, without submitting anything
+    **/
+    void wait()
+    {
+        pollfd ringFd;
+        ringFd.fd = _fd;
+        ringFd.events = POLLIN;
+        ringFd.revents = 0;
+        poll(&ringFd, 1, -1);
+    }
+
+    /**
+       The number of queued entries the kernel has not consumed yet
+    **/
+    unsigned pending() const
+    {
+        return _pending;
+    }
+
+    /**
+       Pop the next completion, if any
+    **/
+    bool pop(io_uring_cqe& cqe)
+    {
+        const unsigned head = *_cqHead;
+        if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+            return false;
+        cqe = _cqes[head & _cqMask];
+        __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    void* _map(size_t size, off_t offset)
+    {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    void _release()
+    {
+        if (_sqes != nullptr)
+            munmap(_sqes, _sqesSize);
+        if (_cq != nullptr && _cq != _sq)
+            munmap(_cq, _cqSize);
+        if (_sq != nullptr)
+            munmap(_sq, _sqSize);
+        if (_fd >= 0)
+            close(_fd);
+        _sqes = nullptr;
+        _sq = _cq = nullptr;
+        _fd = -1;
+    }
+
+    int _fd = -1;
+    void* _sq = nullptr;
+    void* _cq = nullptr;
+    size_t _sqSize = 0;
+    size_t _cqSize = 0;
+    size_t _sqesSize = 0;
+
+    unsigned* _sqHead = nullptr;
+    unsigned* _sqTail = nullptr;
+    unsigned* _sqArray = nullptr;
+    unsigned _sqMask = 0;
+    unsigned _sqEntries = 0;
+    unsigned _sqLocalTail = 0;
+    unsigned _pending = 0;
+    io_uring_sqe* _sqes = nullptr;
+
+    unsigned* _cqHead = nullptr;
+    unsigned* _cqTail = nullptr;
+    unsigned _cqMask = 0;
+    io_uring_cqe* _cqes = nullptr;
+};
+
+// The files of a batch are opened and stat-ed together, then read together
+const unsigned _ringEntries = 64;
+
+enum Operation : uint64_t { OPEN, STATX, READ, CANCEL };
+
+uint64_t _userData(size_t file, Operation operation)
+{
+    const uint64_t index = file;
+    return index << 2 | operation;
+}
+
+/**
+   Read the files [begin, end) through the ring, the files failing for any
+   reason are marked by a negative fd and read again with blocking calls
+**/
+bool _readBatch(Ring& ring,
+    const std::vector<morphio::URI>& uris,
+    size_t begin,
+    size_t end,
+    std::vector<morphio::readers::FileContent>& contents)
+{
+    const size_t count = end - begin;
+    std::vector<int> fds(count, -1);
+    std::vector<struct statx> stats(count);
+    std::vector<size_t> done(count, 0);
+    std::vector<bool> failed(count, false);
+    // The operations of each file in flight, one bit per Operation
+    std::vector<unsigned> inFlight(count, 0);
+    size_t waiting = 0;
+
+    auto complete = [&](io_uring_cqe& cqe) {
+        const size_t i = static_cast<size_t>(cqe.user_data >> 2) - begin;
+        const uint64_t operation = cqe.user_data & 3;
+        --waiting;
+        if (operation == CANCEL)
+            return;
+        inFlight[i] &= ~(1u << operation);
+        if (cqe.res < 0) {
+            failed[i] = true;
+            return;
+        }
+        if (operation == OPEN)
+            fds[i] = cqe.res;
+        else if (operation == READ) {
+            if (cqe.res == 0)
+                failed[i] = true; // the file shrank
+            done[i] += static_cast<size_t>(cqe.res);
+        }
+    };
+
+    // Queue an operation, first waiting for completions if as many
+    // operations as ring entries are in flight: the completion ring, twice
+    // as large, can then never overflow
+    auto queue = [&](size_t i, Operation operation) -> io_uring_sqe* {
+        io_uring_sqe* sqe = nullptr;
+        while (waiting >= ring.entries() ||
+               (sqe = ring.queue(_userData(begin + i, operation))) == nullptr) {
+            if (!ring.submitAndWait())
+                return nullptr;
+            io_uring_cqe cqe;
+            while (ring.pop(cqe))
+                complete(cqe);
+        }
+        ++waiting;
+        inFlight[i] |= 1u << operation;
+        return sqe;
+    };
+
+    auto drain = [&]() {
+        while (waiting > 0) {
+            if (!ring.submitAndWait())
+                return false;
+            io_uring_cqe cqe;
+            while (ring.pop(cqe))
+                complete(cqe);
+        }
+        return true;
+    };
+
+    bool ok = true;
+    for (size_t i = 0; ok && i < count; ++i) {
+        // Each entry is filled before the next one is queued, queuing can
+        // submit the entries queued before
+        io_uring_sqe* openSqe = queue(i, OPEN);
+        if (openSqe == nullptr) {
+            ok = false;
+            break;
+        }
+        openSqe->opcode = IORING_OP_OPENAT;
+        openSqe->fd = AT_FDCWD;
+        openSqe->addr = reinterpret_cast<uint64_t>(uris[begin + i].c_str());
+        openSqe->open_flags = static_cast<uint32_t>(O_RDONLY | O_CLOEXEC);
+
+        io_uring_sqe* statSqe = queue(i, STATX);
+        if (statSqe == nullptr) {
+            ok = false;
+            break;
+        }
+        statSqe->opcode = IORING_OP_STATX;
+        statSqe->fd = AT_FDCWD;
+        statSqe->addr = reinterpret_cast<uint64_t>(uris[begin + i].c_str());
+        statSqe->len = STATX_SIZE;
+        statSqe->off = reinterpret_cast<uint64_t>(&stats[i]);
+    }
+    ok = ok && drain();
+
+    // Reads returning less than requested are queued again until the whole
+    // file is read
+    bool reading = true;
+    while (ok && reading) {
+        reading = false;
+        for (size_t i = 0; ok && i < count; ++i) {
+            if (failed[i] || fds[i] < 0)
+                continue;
+            auto& data = contents[begin + i].data;
+            if (done[i] == 0 && data.empty())
+                data.resize(static_cast<size_t>(stats[i].stx_size));
+            if (done[i] >= data.size())
+                continue;
+
+            io_uring_sqe* readSqe = queue(i, READ);
+            if (readSqe == nullptr) {
+                ok = false;
+                break;
+            }
+            readSqe->opcode = IORING_OP_READ;
+            readSqe->fd = fds[i];
+            readSqe->addr = reinterpret_cast<uint64_t>(&data[done[i]]);
+            readSqe->len = static_cast<uint32_t>(std::min<size_t>(data.size() - done[i], 1u << 30));
+            readSqe->off = done[i];
+            reading = true;
+        }
+        ok = ok && drain();
+    }
+
+    // When the ring fails, the operations already submitted can still open
+    // files and write to the stats and data buffers: they are cancelled,
+    // as far as the ring has room for the cancellations, and all their
+    // completions are reaped before releasing anything, so that the files
+    // opened late are closed below
+    if (!ok) {
+        for (size_t i = 0; i < count; ++i)
+            for (uint64_t operation = OPEN; operation <= READ; ++operation) {
+                if ((inFlight[i] & (1u << operation)) == 0)
+                    continue;
+                io_uring_sqe* cancelSqe = ring.queue(_userData(begin + i, CANCEL));
+                if (cancelSqe == nullptr)
+                    break;
+                ++waiting;
+                cancelSqe->opcode = IORING_OP_ASYNC_CANCEL;
+                cancelSqe->addr = _userData(begin + i, static_cast<Operation>(operation));
+            }
+        ring.submit();
+
+        // The entries the kernel did not take are never submitted, the ring
+        // being dropped by the caller
+        while (true) {
+            io_uring_cqe cqe;
+            while (ring.pop(cqe))
+                complete(cqe);
+            if (waiting == ring.pending())
+                break;
+            ring.wait();
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (fds[i] >= 0)
+            close(fds[i]);
+        if (!ok || failed[i] || fds[i] < 0) {
+            contents[begin + i] = morphio::readers::FileContent();
+            _readFile(uris[begin + i], contents[begin + i]);
+        }
+    }
+    return ok;
+}
+#endif
+} // namespace
+
+namespace morphio {
+namespace readers {
+std::vector<FileContent> readFiles(const std::vector<URI>& uris)
+{
+    std::vector<FileContent> contents(uris.size());
+    size_t next = 0;
+
+#ifdef MORPHIO_USE_IO_URING
+    if (uris.size() > 1) {
+        // Each thread sets up its ring on its first call and keeps it. A
+        // ring failing mid-way is dropped, the next call sets up a new one.
+        // A ring that can not be set up is kept, to fall back to blocking
+        // reads without trying again.
+        thread_local std::unique_ptr<Ring> ring;
+        if (!ring)
+            ring.reset(new Ring(_ringEntries));
+        const size_t batch = ring->entries() / 2;
+        while (ring->valid() && next < uris.size()) {
+            const size_t end = std::min(uris.size(), next + batch);
+            const bool ok = _readBatch(*ring, uris, next, end, contents);
+            next = end;
+            if (!ok) {
+                ring.reset();
+                break;
+            }
+        }
+    }
+#endif
+
+    for (; next < uris.size(); ++next)
+        _readFile(uris[next], contents[next]);
+    return contents;
+}
+} // namespace readers
+} // namespace morphio
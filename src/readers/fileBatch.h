@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+namespace readers {
+/**
+   The content of a file read by readFiles, error is not empty if the file
+   could not be read
+**/
+struct FileContent
+{
+    std::string data;
+    std::string error;
+};
+
+/**
+   Read whole files, in the order of uris
+
+   On Linux, when MorphIO is built with io_uring support and the kernel
+   allows it, the opens, size queries and reads of the files are submitted
+   to the kernel in batches and complete asynchronously. Otherwise, and for
+   any file whose asynchronous read fails, the files are read one after the
+   other with blocking calls. Each calling thread keeps its io_uring
+   instance from one call to the next.
+**/
+std::vector<FileContent> readFiles(const std::vector<URI>& uris);
+} // namespace readers
+} // namespace morphio
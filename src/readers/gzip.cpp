@@ -0,0 +1,65 @@
+#include "gzip.h"
+
+#include <algorithm> // std::max
+
+#include <morphio/errorMessages.h>
+#include <morphio/exceptions.h>
+
+#ifdef MORPHIO_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace morphio {
+namespace readers {
+namespace gzip {
+namespace {
+// Size of the chunks read from the decompressor
+const unsigned int _chunkSize = 1 << 16;
+} // namespace
+
+bool isCompressed(const URI& uri)
+{
+    const size_t pos = uri.find_last_of(".");
+    return pos != std::string::npos && (uri.compare(pos, std::string::npos, ".gz") == 0 ||
+                                           uri.compare(pos, std::string::npos, ".GZ") == 0);
+}
+
+#ifdef MORPHIO_USE_ZLIB
+std::string inflate(const URI& uri)
+{
+    gzFile file = gzopen(uri.c_str(), "rb");
+    if (file == nullptr)
+        LBTHROW(RawDataError(ErrorMessages(uri).ERROR_OPENING_FILE()));
+    gzbuffer(file, _chunkSize);
+
+    std::string contents;
+    int read = 0;
+    do {
+        const size_t size = contents.size();
+        contents.resize(size + _chunkSize);
+        read = gzread(file, &contents[size], _chunkSize);
+        contents.resize(size + static_cast<size_t>(std::max(read, 0)));
+    } while (read > 0);
+
+    // A truncated stream is only reported by gzerror, as Z_BUF_ERROR
+    int code = Z_OK;
+    const std::string reason = gzerror(file, &code);
+    if (read < 0 || code != Z_OK) {
+        gzclose(file);
+        LBTHROW(RawDataError(ErrorMessages(uri).ERROR_DECOMPRESSING_FILE(reason)));
+    }
+
+    gzclose(file);
+    return contents;
+}
+#else
+std::string inflate(const URI& uri)
+{
+    LBTHROW(RawDataError(ErrorMessages(uri).ERROR_DECOMPRESSING_FILE(
+        "MorphIO was built without zlib")));
+}
+#endif
+
+} // namespace gzip
+} // namespace readers
+} // namespace morphio
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string> // std::string
+
+#include <morphio/types.h>
+
+namespace morphio {
+namespace readers {
+namespace gzip {
+/**
+   Is uri a gzip compressed file, ie. does it end in .gz
+**/
+bool isCompressed(const URI& uri);
+
+/**
+   Decompress the gzip file uri in memory
+
+   The file is streamed through zlib in fixed size chunks, nothing is written
+   to disk. Throw a RawDataError if MorphIO was built without zlib.
+**/
+std::string inflate(const URI& uri);
+} // namespace gzip
+} // namespace readers
+} // namespace morphio
@@ -101,6 +101,15 @@ constexpr std::size_t operator+(Token type)
     return static_cast<std::size_t>(type);
 }
 
+/**
+   The Neurolucida state machine
+
+   Building and minimising the DFA costs much more than lexing a typical
+   file, so it is built once, on first use, and shared by all the lexers.
+   The initialization of a function-local static is thread-safe.
+**/
+inline const lexertl::state_machine& neurolucida_state_machine();
+
 class NeurolucidaLexer
 {
 private:
@@ -108,10 +117,10 @@ private:
     bool debug_;
     ErrorMessages err_;
 
-    lexertl::state_machine sm_;
+    const lexertl::state_machine& sm_;
 
-    lexertl::siterator current_;
-    lexertl::siterator next_;
+    lexertl::citerator current_;
+    lexertl::citerator next_;
 
     mutable size_t current_line_num_ = 1;
     mutable size_t next_line_num_ = 1;
@@ -123,14 +132,19 @@ public:
         : uri_(uri)
         , debug_(debug)
         , err_(uri)
+        , sm_(neurolucida_state_machine())
     {
-        lexertl::rules rules;
-        build_lexer(rules);
+        if (debug_) {
+            lexertl::debug::dump(sm_, std::cout);
+        }
     }
 
-    void start_parse(const std::string& input)
+    /**
+       Lex [begin, end) in place, the buffer must outlive the parse
+    **/
+    void start_parse(const char* begin, const char* end)
     {
-        current_ = next_ = lexertl::siterator(input.begin(), input.end(), sm_);
+        current_ = next_ = lexertl::citerator(begin, end, sm_);
         // will set the above, current_ to next_, AND consume whitespace
         size_t n_skipped = skip_whitespace(current_);
         current_line_num_ += n_skipped;
@@ -139,7 +153,7 @@ public:
         consume();
     }
 
-    void build_lexer(lexertl::rules& rules_)
+    static void build_lexer(lexertl::rules& rules_, lexertl::state_machine& sm)
     {
         rules_.push("\n", +Token::NEWLINE);
         rules_.push("[ \t\r]+", +Token::WS);
@@ -174,19 +188,16 @@ public:
         rules_.push("-?[0-9]+(\\.[0-9]+)?([eE][+-]?[0-9]+)?", +Token::NUMBER);
         rules_.push("[a-zA-Z][0-9a-zA-Z]+", +Token::WORD);
 
-        lexertl::generator::build(rules_, sm_);
-        sm_.minimise();
-        if (debug_) {
-            lexertl::debug::dump(sm_, std::cout);
-        }
+        lexertl::generator::build(rules_, sm);
+        sm.minimise();
     }
 
     size_t line_num() const { return current_line_num_; }
-    lexertl::siterator current() const { return current_; }
-    lexertl::siterator peek() const { return next_; }
-    size_t skip_whitespace(lexertl::siterator& iter)
+    lexertl::citerator current() const { return current_; }
+    lexertl::citerator peek() const { return next_; }
+    size_t skip_whitespace(lexertl::citerator& iter)
     {
-        const lexertl::siterator end;
+        const lexertl::citerator end;
         size_t endlines = 0;
         while (iter != end) {
             if (iter->id == +Token::NEWLINE) {
@@ -203,28 +214,28 @@ public:
 
     bool ended() const
     {
-        const lexertl::siterator end;
+        const lexertl::citerator end;
         return current() == end;
     }
 
-    lexertl::siterator consume(Token t, std::string msg = "")
+    lexertl::citerator consume(Token t, const char* msg = "")
     {
-        if (!msg.empty()) {
-            expect(t, msg.c_str());
+        if (*msg != '\0') {
+            expect(t, msg);
         } else {
             expect(t, "Consume");
         }
         return consume();
     }
 
-    lexertl::siterator consume()
+    lexertl::citerator consume()
     {
-        const lexertl::siterator end;
+        const lexertl::citerator end;
         if (ended()) {
             throw RawDataError(err_.ERROR_EOF_REACHED(line_num()));
         }
 
-        lexertl::siterator temp(next_);
+        lexertl::citerator temp(next_);
         current_ = next_;
         next_ = temp;
 
@@ -293,6 +304,17 @@ public:
     }
 };
 
+inline const lexertl::state_machine& neurolucida_state_machine()
+{
+    static const lexertl::state_machine sm = [] {
+        lexertl::rules rules;
+        lexertl::state_machine machine;
+        NeurolucidaLexer::build_lexer(rules, machine);
+        return machine;
+    }();
+    return sm;
+}
+
 } // namespace asc
 } // namespace readers
 } // namespace morphio
@@ -0,0 +1,49 @@
+#include "memoryMap.h"
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap / munmap / madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+#include <morphio/errorMessages.h>
+#include <morphio/exceptions.h>
+
+namespace morphio {
+namespace readers {
+MemoryMap::MemoryMap(const std::string& uri, bool sequential)
+    : _data(nullptr)
+    , _size(0)
+{
+    const int fd = open(uri.c_str(), O_RDONLY);
+    if (fd == -1)
+        LBTHROW(RawDataError(ErrorMessages(uri).ERROR_OPENING_FILE()));
+
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        LBTHROW(RawDataError(ErrorMessages(uri).ERROR_OPENING_FILE()));
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size > 0) {
+        void* ptr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED) {
+            close(fd);
+            LBTHROW(RawDataError(ErrorMessages(uri).ERROR_OPENING_FILE()));
+        }
+        madvise(ptr, _size, sequential ? MADV_SEQUENTIAL : MADV_NORMAL);
+        _data = static_cast<const char*>(ptr);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+}
+
+MemoryMap::~MemoryMap()
+{
+    if (_data != nullptr)
+        munmap(const_cast<char*>(_data), _size);
+}
+
+} // namespace readers
+} // namespace morphio
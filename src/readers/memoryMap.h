@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <string>  // std::string
+
+namespace morphio {
+namespace readers {
+/**
+   Read-only memory mapping of a whole file
+
+   Following RAII, the file is mapped upon construction and unmapped upon
+   destruction. Mapping an empty file is valid: data() is then nullptr and
+   size() is 0.
+
+   sequential tells the kernel the file is read front to back, it should be
+   false for files whose parts are read in any order.
+**/
+class MemoryMap
+{
+public:
+    explicit MemoryMap(const std::string& uri, bool sequential = true);
+    ~MemoryMap();
+
+    MemoryMap(const MemoryMap&) = delete;
+    MemoryMap& operator=(const MemoryMap&) = delete;
+
+    const char* data() const { return _data; }
+    std::size_t size() const { return _size; }
+    const char* begin() const { return _data; }
+    const char* end() const { return _data + _size; }
+
+private:
+    const char* _data;
+    std::size_t _size;
+};
+
+} // namespace readers
+} // namespace morphio
@@ -1,6 +1,7 @@
 #include "morphologyASC.h"
 
-#include <fstream>
+#include "memoryMap.h"
+#include "parseNumber.h"
 
 #include <morphio/mut/morphology.h>
 #include <morphio/mut/section.h>
@@ -57,8 +58,10 @@ bool skip_sexp(size_t id)
 class NeurolucidaParser
 {
 public:
-    NeurolucidaParser(const std::string& uri)
-        : uri_(uri)
+    NeurolucidaParser(const std::string& uri,
+        const std::set<SectionType>& sectionTypes = {})
+        : sectionTypes_(sectionTypes)
+        , uri_(uri)
         , lex_(uri)
         , debugInfo_(uri)
         , err_(uri)
@@ -68,13 +71,9 @@ public:
     NeurolucidaParser(NeurolucidaParser const&) = delete;
     NeurolucidaParser& operator=(NeurolucidaParser const&) = delete;
 
-    morphio::mut::Morphology& parse()
+    morphio::mut::Morphology& parse(const char* begin, const char* end)
     {
-        std::ifstream ifs(uri_);
-        std::string input((std::istreambuf_iterator<char>(ifs)),
-            (std::istreambuf_iterator<char>()));
-
-        lex_.start_parse(input);
+        lex_.start_parse(begin, end);
 
         parse_block();
 
@@ -87,8 +86,13 @@ private:
         lex.expect(Token::LPAREN, "Point should start in LPAREN");
         std::array<float, 4> point; // X,Y,Z,R
         for (auto& p : point) {
+            const auto token = lex.consume();
+            if (parseFloat(token->first, token->second, p))
+                continue;
+
+            // What is not a plain number keeps the std::stof semantics
             try {
-                p = std::stof(lex.consume()->str());
+                p = std::stof(token->str());
             } catch (const std::invalid_argument&) {
                 throw RawDataError(
                     err_.ERROR_PARSING_POINT(lex.line_num(),
@@ -124,21 +128,21 @@ private:
         return ret;
     }
 
+    /**
+       Create the soma or section from the points parsed in properties, which
+       is then cleared to be reused by the next section
+    **/
     int32_t _create_soma_or_section(Token token,
                                     int32_t parent_id,
-                                    std::vector<Point>& points,
-                                    std::vector<float>& diameters)
+                                    morphio::Property::PointLevel& properties)
     {
         lex_.current_section_start_ = lex_.line_num();
         int32_t return_id;
-        morphio::Property::PointLevel properties;
-        properties._points = points;
-        properties._diameters = diameters;
         if (token == Token::CELLBODY) {
             if (nb_.soma()->points().size() != 0)
                 throw SomaError(
                     err_.ERROR_SOMA_ALREADY_DEFINED(lex_.line_num()));
-            nb_.soma()->properties() = properties;
+            nb_.soma()->properties() = std::move(properties);
 
             return_id = -1;
         } else {
@@ -153,16 +157,16 @@ private:
             } else {
                 std::shared_ptr<morphio::mut::Section> section;
                 if (parent_id > -1)
-                    section = nb_.section(static_cast<unsigned int>(parent_id))->appendSection(properties, section_type);
+                    section = nb_.section(static_cast<unsigned int>(parent_id))->appendSection(std::move(properties), section_type);
                 else
-                    section = nb_.appendRootSection(properties, section_type);
+                    section = nb_.appendRootSection(std::move(properties), section_type);
                 return_id = static_cast<int>(section->id());
                 debugInfo_.setLineNumber(section->id(),
                     static_cast<unsigned int>(lex_.current_section_start_));
             }
         }
-        points.clear();
-        diameters.clear();
+        properties._points.clear();
+        properties._diameters.clear();
 
         return return_id;
     }
@@ -204,8 +208,9 @@ private:
 
     bool parse_neurite_section(int32_t parent_id, Token token)
     {
-        Points points;
-        std::vector<float> diameters;
+        morphio::Property::PointLevel properties;
+        auto& points = properties._points;
+        auto& diameters = properties._diameters;
         int32_t section_id = static_cast<int>(nb_.sections().size());
 
         while (true) {
@@ -216,7 +221,7 @@ private:
                 throw RawDataError(err_.ERROR_EOF_IN_NEURITE(lex_.line_num()));
             } else if (is_end_of_section(id)) {
                 if (!points.empty())
-                    _create_soma_or_section(token, parent_id, points, diameters);
+                    _create_soma_or_section(token, parent_id, properties);
                 return true;
             } else if (is_end_of_branch(id)) {
                 lex_.consume();
@@ -239,7 +244,7 @@ private:
                 } else if (peek_id == +Token::LPAREN) {
                     if (!points.empty()) {
                         section_id = _create_soma_or_section(token, parent_id,
-                            points, diameters);
+                            properties);
                     }
                     parse_neurite_branch(section_id, token);
                 } else {
@@ -255,6 +260,32 @@ private:
         }
     }
 
+    bool is_selected(Token token) const
+    {
+        return sectionTypes_.empty() || token == Token::CELLBODY ||
+               sectionTypes_.count(TokenSectionTypeMap.at(token)) > 0;
+    }
+
+    // Advance to the RPAREN closing the current neurite without building it
+    void skip_neurite()
+    {
+        size_t opening_count = 0;
+        while (true) {
+            if (lex_.ended() || is_eof(static_cast<Token>(lex_.current()->id)))
+                throw RawDataError(err_.ERROR_EOF_IN_NEURITE(lex_.line_num()));
+
+            const size_t id = lex_.current()->id;
+            if (id == +Token::RPAREN) {
+                if (opening_count == 0)
+                    return;
+                --opening_count;
+            } else if (id == +Token::LPAREN) {
+                ++opening_count;
+            }
+            lex_.consume();
+        }
+    }
+
     bool parse_block()
     {
         // parse the top level blocks, and if they are a neurite, otherwise skip
@@ -266,7 +297,10 @@ private:
 
                 lex_.consume();
                 lex_.consume(Token::RPAREN, "New Neurite should end in RPAREN");
-                parse_neurite_section(-1, current_id);
+                if (is_selected(current_id))
+                    parse_neurite_section(-1, current_id);
+                else
+                    skip_neurite();
             }
 
             if (!lex_.ended())
@@ -278,6 +312,7 @@ private:
 
     morphio::mut::Morphology nb_;
 
+    std::set<SectionType> sectionTypes_;
     std::string uri_;
     NeurolucidaLexer lex_;
 
@@ -288,11 +323,16 @@ private:
     ErrorMessages err_;
 };
 
-Property::Properties load(const URI& uri, unsigned int options)
+namespace {
+Property::Properties _load(const URI& uri,
+    const char* begin,
+    const char* end,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
 {
-    NeurolucidaParser parser(uri);
+    NeurolucidaParser parser(uri, sectionTypes);
 
-    morphio::mut::Morphology& nb_ = parser.parse();
+    morphio::mut::Morphology& nb_ = parser.parse(begin, end);
     nb_.sanitize(parser.debugInfo_);
     nb_.applyModifiers(options);
 
@@ -301,6 +341,24 @@ Property::Properties load(const URI& uri, unsigned int options)
     properties._cellLevel._version = MORPHOLOGY_VERSION_ASC_1;
     return properties;
 }
+} // namespace
+
+Property::Properties load(const URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+{
+    const MemoryMap map(uri);
+    return _load(uri, map.begin(), map.end(), options, sectionTypes);
+}
+
+Property::Properties load(const URI& uri,
+    const char* data,
+    size_t size,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+{
+    return _load(uri, data, data + size, options, sectionTypes);
+}
 
 } // namespace asc
 } // namespace readers
@@ -1,10 +1,28 @@
 #pragma once
+#include <set> // std::set
+
+#include <morphio/properties.h>
 #include <morphio/types.h>
 
 namespace morphio {
 namespace readers {
 namespace asc {
-Property::Properties load(const URI& uri, unsigned int options);
+/**
+   Only the neurites whose root section has one of the given sectionTypes are
+   built, an empty set builds all of them
+**/
+Property::Properties load(const URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes = {});
+
+/**
+   Parse the ASC content held in memory, uri is only used in error messages
+**/
+Property::Properties load(const URI& uri,
+    const char* data,
+    size_t size,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes = {});
 } // namespace asc
 } // namespace readers
 } // namespace morphio
@@ -0,0 +1,263 @@
+#include "morphologyBinary.h"
+
+#include <cstdint> // uint32_t / uint64_t
+#include <cstring> // std::memcpy
+#include <fstream>
+#include <vector>
+
+#include <morphio/errorMessages.h>
+
+#include "memoryMap.h"
+
+/**
+   Layout of a .mbin file (all integers are little endian on the platforms we
+   support, a byte order mark is stored to detect foreign files):
+
+   - a fixed size Header (magic, format version, cell level information and
+     one (offset, count) entry per array)
+   - the arrays of Property::Properties, each one starting at an offset aligned
+     on _alignment bytes so that the mapped memory can be used as is
+
+   The children index is not stored, it is rebuilt in one linear pass over the
+   section parents like for every other format.
+**/
+
+namespace {
+const char _magic[8] = {'M', 'O', 'R', 'P', 'H', 'B', 'I', 'N'};
+const uint32_t _formatVersion = 1;
+const uint32_t _byteOrderMark = 0x01020304;
+const uint64_t _alignment = 64;
+
+enum Array : uint32_t
+{
+    POINTS,
+    DIAMETERS,
+    PERIMETERS,
+    SECTIONS,
+    SECTION_TYPES,
+    SOMA_POINTS,
+    SOMA_DIAMETERS,
+    MITO_NEURITE_SECTION_IDS,
+    MITO_PATH_LENGTHS,
+    MITO_DIAMETERS,
+    MITO_SECTIONS,
+    N_ARRAYS
+};
+
+struct ArrayEntry
+{
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct Header
+{
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t byteOrderMark;
+    int32_t cellFamily;
+    int32_t somaType;
+    int32_t version;
+    uint32_t nArrays;
+    ArrayEntry arrays[N_ARRAYS];
+};
+
+static_assert(sizeof(morphio::Point) == 3 * sizeof(float),
+    "Points must be stored contiguously to be copied in one block");
+static_assert(sizeof(morphio::SectionType) == sizeof(int32_t),
+    "Section types are stored as 32 bits integers");
+
+uint64_t _align(uint64_t offset)
+{
+    return (offset + _alignment - 1) / _alignment * _alignment;
+}
+
+template <typename T>
+void _readArray(const char* buffer,
+    size_t size,
+    const Header& header,
+    Array array,
+    std::vector<T>& data,
+    const std::string& uri)
+{
+    const ArrayEntry& entry = header.arrays[array];
+    if (entry.offset > size || entry.count > (size - entry.offset) / sizeof(T))
+        LBTHROW(morphio::RawDataError("Reading morphology file '" + uri +
+                                      "': array " + std::to_string(array) + " is out of the file bounds"));
+
+    data.resize(entry.count);
+    if (entry.count > 0)
+        std::memcpy(data.data(), buffer + entry.offset, entry.count * sizeof(T));
+}
+
+template <typename T>
+void _writeArray(std::ofstream& file,
+    uint64_t& position,
+    const ArrayEntry& entry,
+    const std::vector<T>& data)
+{
+    static const char padding[_alignment] = {};
+    file.write(padding, static_cast<std::streamsize>(entry.offset - position));
+    file.write(reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size() * sizeof(T)));
+    position = entry.offset + data.size() * sizeof(T);
+}
+
+// Check that the (offset, parent) rows start in increasing order within
+// nPoints and that the parents exist
+void _checkSections(const std::vector<morphio::Property::Section::Type>& sections,
+    size_t nPoints,
+    const std::string& kind,
+    const morphio::URI& uri)
+{
+    int32_t previousOffset = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const auto& section = sections[i];
+        if (section[0] < previousOffset || static_cast<size_t>(section[0]) > nPoints ||
+            section[1] < -1 || section[1] >= static_cast<int>(sections.size()))
+            LBTHROW(morphio::RawDataError("Reading morphology file '" + uri + "': " + kind + " " +
+                                          std::to_string(i) + " is out of bounds"));
+        previousOffset = section[0];
+    }
+}
+
+morphio::Property::Properties _load(const char* buffer, size_t size, const morphio::URI& uri)
+{
+    using namespace morphio;
+
+    Header header;
+    if (size < sizeof(Header))
+        LBTHROW(RawDataError("Reading morphology file '" + uri + "': file is too small"));
+    std::memcpy(&header, buffer, sizeof(Header));
+
+    if (std::memcmp(header.magic, _magic, sizeof(_magic)) != 0)
+        LBTHROW(RawDataError("Reading morphology file '" + uri + "': not a MorphIO binary file"));
+    if (header.byteOrderMark != _byteOrderMark)
+        LBTHROW(RawDataError("Reading morphology file '" + uri + "': unsupported byte order"));
+    if (header.formatVersion != _formatVersion || header.nArrays != N_ARRAYS)
+        LBTHROW(RawDataError("Reading morphology file '" + uri + "': unsupported format version " +
+                             std::to_string(header.formatVersion)));
+
+    Property::Properties properties;
+    properties._cellLevel._cellFamily = static_cast<CellFamily>(header.cellFamily);
+    properties._cellLevel._somaType = static_cast<SomaType>(header.somaType);
+    properties._cellLevel._version = static_cast<MorphologyVersion>(header.version);
+
+    _readArray(buffer, size, header, POINTS, properties.get<Property::Point>(), uri);
+    _readArray(buffer, size, header, DIAMETERS, properties.get<Property::Diameter>(), uri);
+    _readArray(buffer, size, header, PERIMETERS, properties.get<Property::Perimeter>(), uri);
+    _readArray(buffer, size, header, SECTIONS, properties.get<Property::Section>(), uri);
+    _readArray(buffer, size, header, SECTION_TYPES, properties.get<Property::SectionType>(), uri);
+    _readArray(buffer, size, header, SOMA_POINTS, properties._somaLevel._points, uri);
+    _readArray(buffer, size, header, SOMA_DIAMETERS, properties._somaLevel._diameters, uri);
+    _readArray(buffer, size, header, MITO_NEURITE_SECTION_IDS, properties.get<Property::MitoNeuriteSectionId>(), uri);
+    _readArray(buffer, size, header, MITO_PATH_LENGTHS, properties.get<Property::MitoPathLength>(), uri);
+    _readArray(buffer, size, header, MITO_DIAMETERS, properties.get<Property::MitoDiameter>(), uri);
+    _readArray(buffer, size, header, MITO_SECTIONS, properties.get<Property::MitoSection>(), uri);
+
+    const auto& sections = properties.get<Property::Section>();
+    const size_t nPoints = properties.get<Property::Point>().size();
+    const size_t nPerimeters = properties.get<Property::Perimeter>().size();
+    const size_t nMitoPoints = properties.get<Property::MitoDiameter>().size();
+    if (properties.get<Property::Diameter>().size() != nPoints ||
+        (nPerimeters != 0 && nPerimeters != nPoints) ||
+        properties.get<Property::SectionType>().size() != sections.size() ||
+        properties._somaLevel._diameters.size() != properties._somaLevel._points.size() ||
+        properties.get<Property::MitoNeuriteSectionId>().size() != nMitoPoints ||
+        properties.get<Property::MitoPathLength>().size() != nMitoPoints)
+        LBTHROW(RawDataError("Reading morphology file '" + uri + "': inconsistent array sizes"));
+
+    _checkSections(sections, nPoints, "section", uri);
+    _checkSections(properties.get<Property::MitoSection>(), nMitoPoints, "mitochondrial section", uri);
+
+    for (const uint32_t sectionId : properties.get<Property::MitoNeuriteSectionId>())
+        if (sectionId >= sections.size())
+            LBTHROW(RawDataError("Reading morphology file '" + uri +
+                                 "': mitochondrial point on the missing section " +
+                                 std::to_string(sectionId)));
+
+    return properties;
+}
+} // namespace
+
+namespace morphio {
+namespace readers {
+namespace binary {
+Property::Properties load(const URI& uri)
+{
+    MemoryMap map(uri);
+    return _load(map.data(), map.size(), uri);
+}
+
+Property::Properties load(const URI& uri, const char* data, size_t size)
+{
+    return _load(data, size, uri);
+}
+
+void write(const Property::Properties& properties, const std::string& filename)
+{
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, _magic, sizeof(_magic));
+    header.formatVersion = _formatVersion;
+    header.byteOrderMark = _byteOrderMark;
+    header.cellFamily = properties._cellLevel._cellFamily;
+    header.somaType = properties._cellLevel._somaType;
+    header.version = properties._cellLevel._version;
+    header.nArrays = N_ARRAYS;
+
+    uint64_t offset = _align(sizeof(Header));
+    auto layout = [&header, &offset](Array array, size_t count, size_t elementSize) {
+        header.arrays[array] = ArrayEntry{offset, count};
+        offset = _align(offset + count * elementSize);
+    };
+
+    const auto& points = properties.get<Property::Point>();
+    const auto& diameters = properties.get<Property::Diameter>();
+    const auto& perimeters = properties.get<Property::Perimeter>();
+    const auto& sections = properties.get<Property::Section>();
+    const auto& sectionTypes = properties.get<Property::SectionType>();
+    const auto& somaPoints = properties._somaLevel._points;
+    const auto& somaDiameters = properties._somaLevel._diameters;
+    const auto& mitoSectionIds = properties.get<Property::MitoNeuriteSectionId>();
+    const auto& mitoPathLengths = properties.get<Property::MitoPathLength>();
+    const auto& mitoDiameters = properties.get<Property::MitoDiameter>();
+    const auto& mitoSections = properties.get<Property::MitoSection>();
+
+    layout(POINTS, points.size(), sizeof(Property::Point::Type));
+    layout(DIAMETERS, diameters.size(), sizeof(Property::Diameter::Type));
+    layout(PERIMETERS, perimeters.size(), sizeof(Property::Perimeter::Type));
+    layout(SECTIONS, sections.size(), sizeof(Property::Section::Type));
+    layout(SECTION_TYPES, sectionTypes.size(), sizeof(Property::SectionType::Type));
+    layout(SOMA_POINTS, somaPoints.size(), sizeof(Property::Point::Type));
+    layout(SOMA_DIAMETERS, somaDiameters.size(), sizeof(Property::Diameter::Type));
+    layout(MITO_NEURITE_SECTION_IDS, mitoSectionIds.size(), sizeof(Property::MitoNeuriteSectionId::Type));
+    layout(MITO_PATH_LENGTHS, mitoPathLengths.size(), sizeof(Property::MitoPathLength::Type));
+    layout(MITO_DIAMETERS, mitoDiameters.size(), sizeof(Property::MitoDiameter::Type));
+    layout(MITO_SECTIONS, mitoSections.size(), sizeof(Property::MitoSection::Type));
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        LBTHROW(WriterError("Could not create morphology file " + filename));
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    uint64_t position = sizeof(Header);
+    _writeArray(file, position, header.arrays[POINTS], points);
+    _writeArray(file, position, header.arrays[DIAMETERS], diameters);
+    _writeArray(file, position, header.arrays[PERIMETERS], perimeters);
+    _writeArray(file, position, header.arrays[SECTIONS], sections);
+    _writeArray(file, position, header.arrays[SECTION_TYPES], sectionTypes);
+    _writeArray(file, position, header.arrays[SOMA_POINTS], somaPoints);
+    _writeArray(file, position, header.arrays[SOMA_DIAMETERS], somaDiameters);
+    _writeArray(file, position, header.arrays[MITO_NEURITE_SECTION_IDS], mitoSectionIds);
+    _writeArray(file, position, header.arrays[MITO_PATH_LENGTHS], mitoPathLengths);
+    _writeArray(file, position, header.arrays[MITO_DIAMETERS], mitoDiameters);
+    _writeArray(file, position, header.arrays[MITO_SECTIONS], mitoSections);
+
+    if (!file)
+        LBTHROW(WriterError("Could not write morphology file " + filename));
+}
+
+} // namespace binary
+} // namespace readers
+} // namespace morphio
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+namespace morphio {
+namespace readers {
+namespace binary {
+/**
+   Load a morphology stored in the MorphIO native binary format (.mbin)
+
+   The file is memory mapped and each array is copied in one block into
+   the Properties, without any parsing or per-element conversion.
+**/
+Property::Properties load(const URI& uri);
+
+/**
+   Load a .mbin content held in memory, uri is only used in error messages
+**/
+Property::Properties load(const URI& uri, const char* data, size_t size);
+
+/**
+   Write the given Properties in the MorphIO native binary format (.mbin)
+**/
+void write(const Property::Properties& properties, const std::string& filename);
+} // namespace binary
+} // namespace readers
+} // namespace morphio
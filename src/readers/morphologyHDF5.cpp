@@ -22,6 +22,9 @@
 
 #include "utilsHDF5.h"
 
+#include <algorithm> // std::fill, std::min
+#include <atomic>    // std::atomic
+
 #include <highfive/H5Utility.hpp> // HighFive::SilenceHDF5
 
 namespace {
@@ -48,19 +51,239 @@ const size_t _structureV2Columns = 2;
 const std::string _g_root("neuron1");
 const std::string _d_type("sectiontype");
 const std::string _a_apical("apical");
+
+// nRows of MorphologyHDF5::_read reading the whole dataset
+const size_t _allRows = static_cast<size_t>(-1);
+
+// Number of rows read at once in the intermediate buffer of _readPointRows,
+// bounding its size whatever the size of the cell
+const size_t _chunkRows = 1 << 16;
+
+/**
+   Read the (x, y, z, diameter) rows [start, start + count) of a points
+   dataset straight into contiguous points and diameters
+**/
+void _readPointRows(const HighFive::DataSet& dataset,
+    size_t start,
+    size_t count,
+    morphio::Point* points,
+    float* diameters)
+{
+    std::vector<float> buffer(std::min(count, _chunkRows) * _pointColumns);
+    for (size_t done = 0; done < count;) {
+        const size_t rows = std::min(count - done, _chunkRows);
+        dataset.select({start + done, 0}, {rows, _pointColumns}).read(buffer.data());
+        for (size_t i = 0; i < rows; ++i) {
+            const float* row = &buffer[i * _pointColumns];
+            points[done + i] = morphio::Point{row[0], row[1], row[2]};
+            diameters[done + i] = row[3];
+        }
+        done += rows;
+    }
+}
+
+/**
+   Append the sections of a flat buffer of (offset, parent) rows whose first
+   row is the soma
+
+   Return the offset of the first neurite point, or -1 if there is no neurite
+
+   @throw RawDataError if a parent is not the soma or one of the sections
+**/
+int _appendSections(const std::vector<int>& rows,
+    std::vector<morphio::Property::Section::Type>& sections,
+    const std::string& filename)
+{
+    const size_t nRows = rows.size() / 2;
+    if (nRows < 2) // Neuron without any neurites
+        return -1;
+
+    const int firstSectionOffset = rows[2];
+    const int nSections = static_cast<int>(nRows - 1);
+    sections.reserve(sections.size() + nRows - 1);
+    for (size_t i = 1; i < nRows; ++i) { // Skipping soma section
+        const int parent = rows[2 * i + 1] - 1;
+        if (parent < -1 || parent >= nSections)
+            LBTHROW(morphio::RawDataError("Reading morphology file '" + filename + "': section " +
+                                          std::to_string(i) + " has an invalid parent " +
+                                          std::to_string(rows[2 * i + 1])));
+        sections.push_back({rows[2 * i] - firstSectionOffset, parent});
+    }
+    return firstSectionOffset;
+}
+
+/**
+   Reads the neurite points, diameters and perimeters on demand, keeping the
+   file open until the last Properties sharing it is destroyed
+**/
+class LazyPointLevel : public morphio::Property::PointLevelLoader
+{
+public:
+    LazyPointLevel(std::unique_ptr<HighFive::File> file,
+        std::unique_ptr<HighFive::DataSet> points,
+        std::unique_ptr<HighFive::DataSet> perimeters,
+        std::vector<std::pair<size_t, size_t>> runs,
+        bool sectionsOnly)
+        : _file(std::move(file))
+        , _points(std::move(points))
+        , _perimeters(std::move(perimeters))
+        , _runs(std::move(runs))
+        , _size(_countRows(_runs))
+        , _sectionsOnly(sectionsOnly)
+        , _nLoaded(0)
+        , _complete(false)
+    {
+    }
+
+    ~LazyPointLevel() override
+    {
+        std::lock_guard<std::recursive_mutex> lock(morphio::readers::h5::globalHDF5Mutex());
+        _perimeters.reset();
+        _points.reset();
+        _file.reset();
+    }
+
+    size_t size() const override
+    {
+        return _size;
+    }
+
+    morphio::Property::PointLevel& load(size_t start, size_t end) override
+    {
+        if (_complete)
+            return _pointLevel;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_loaded.empty()) {
+            _loaded.assign(_size, false);
+            _pointLevel._points.resize(_size);
+            _pointLevel._diameters.resize(_size);
+            if (_perimeters)
+                _pointLevel._perimeters.resize(_size);
+        }
+
+        if (!_sectionsOnly) {
+            start = 0;
+            end = _size;
+        }
+        end = std::min(end, _size);
+
+        // Read the missing runs of points in the requested range
+        for (size_t i = start; i < end;) {
+            if (_loaded[i]) {
+                ++i;
+                continue;
+            }
+            size_t j = i;
+            while (j < end && !_loaded[j])
+                ++j;
+            _read(i, j);
+            std::fill(_loaded.begin() + static_cast<std::ptrdiff_t>(i),
+                _loaded.begin() + static_cast<std::ptrdiff_t>(j), true);
+            _nLoaded += j - i;
+            i = j;
+        }
+
+        if (_nLoaded == _size)
+            _complete = true;
+        return _pointLevel;
+    }
+
+    size_t memoryUsage() const override
+    {
+        size_t pointBytes = sizeof(morphio::Property::Point::Type) +
+                            sizeof(morphio::Property::Diameter::Type);
+        if (_perimeters)
+            pointBytes += sizeof(morphio::Property::Perimeter::Type);
+        return sizeof(LazyPointLevel) + _size * pointBytes + (_size + 7) / 8 +
+               _runs.capacity() * sizeof(_runs[0]);
+    }
+
+private:
+    static size_t _countRows(const std::vector<std::pair<size_t, size_t>>& runs)
+    {
+        size_t count = 0;
+        for (const auto& run : runs)
+            count += run.second;
+        return count;
+    }
+
+    // Read the points [start, end) which may span several runs of the file
+    void _read(size_t start, size_t end)
+    {
+        std::lock_guard<std::recursive_mutex> lock(morphio::readers::h5::globalHDF5Mutex());
+        try {
+            HighFive::SilenceHDF5 silence;
+            size_t base = 0;
+            for (const auto& run : _runs) {
+                const size_t first = std::max(start, base);
+                const size_t last = std::min(end, base + run.second);
+                if (first < last)
+                    _readRows(run.first + first - base, first, last - first);
+                base += run.second;
+                if (base >= end)
+                    break;
+            }
+        } catch (const HighFive::Exception& e) {
+            LBTHROW(morphio::RawDataError("Reading morphology file '" + _file->getName() +
+                                          "': " + e.what()));
+        }
+    }
+
+    void _readRows(size_t row, size_t start, size_t count)
+    {
+        _readPointRows(*_points, row, count, _pointLevel._points.data() + start,
+            _pointLevel._diameters.data() + start);
+
+        if (_perimeters)
+            _perimeters->select({row}, {count}).read(_pointLevel._perimeters.data() + start);
+    }
+
+    std::unique_ptr<HighFive::File> _file;
+    std::unique_ptr<HighFive::DataSet> _points;
+    std::unique_ptr<HighFive::DataSet> _perimeters;
+    const std::vector<std::pair<size_t, size_t>> _runs; // (first row, number of rows)
+    const size_t _size;
+    const bool _sectionsOnly;
+
+    std::mutex _mutex;
+    std::vector<bool> _loaded;
+    size_t _nLoaded;
+    std::atomic<bool> _complete;
+    morphio::Property::PointLevel _pointLevel;
+};
 } // namespace
 
 namespace morphio {
 namespace readers {
 namespace h5 {
-Property::Properties load(const URI& uri)
+std::recursive_mutex& globalHDF5Mutex()
 {
-    return MorphologyHDF5(uri).load();
+    static std::recursive_mutex mutex;
+    return mutex;
 }
 
-Property::Properties MorphologyHDF5::load()
+Property::Properties load(const URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
 {
-    _stage = "repaired";
+    std::lock_guard<std::recursive_mutex> lock(globalHDF5Mutex());
+    return MorphologyHDF5(uri, sectionTypes).load(options);
+}
+
+Property::Properties load(const URI& uri,
+    const char* image,
+    size_t size,
+    const std::set<SectionType>& sectionTypes)
+{
+    std::lock_guard<std::recursive_mutex> lock(globalHDF5Mutex());
+    return MorphologyHDF5(uri, sectionTypes).load(image, size);
+}
+
+Property::Properties MorphologyHDF5::load(unsigned int options)
+{
+    _lazy = options & (LAZY_LOAD | LAZY_LOAD_SECTIONS);
+    _lazySections = options & LAZY_LOAD_SECTIONS;
 
     try {
         HighFive::SilenceHDF5 silence;
@@ -70,13 +293,51 @@ Property::Properties MorphologyHDF5::load()
                                       ? "Could not create morphology file "
                                       : "Could not open morphology file " + _uri + ": " + exc.what()));
     }
+    return _load();
+}
+
+Property::Properties MorphologyHDF5::load(const char* image, size_t size)
+{
+    try {
+        HighFive::SilenceHDF5 silence;
+        _file.reset(new HighFive::File(_uri, HighFive::File::ReadOnly, FileImageDriver(image, size)));
+    } catch (const HighFive::Exception& exc) {
+        LBTHROW(morphio::RawDataError("Could not open morphology file " + _uri + ": " + exc.what()));
+    }
+    return _load();
+}
+
+Property::Properties MorphologyHDF5::load(const HighFive::File& file,
+    const CellRows& cell,
+    unsigned int options)
+{
+    _lazy = options & (LAZY_LOAD | LAZY_LOAD_SECTIONS);
+    _lazySections = options & LAZY_LOAD_SECTIONS;
+    _cell = &cell;
+    _file.reset(new HighFive::File(file));
+    return _load();
+}
+
+Property::Properties MorphologyHDF5::_load()
+{
+    _stage = "repaired";
     _checkVersion(_uri);
     _selectRepairStage();
     int firstSectionOffset = _readSections();
-    _readPoints(firstSectionOffset);
     _readSectionTypes();
+    _selectSections(firstSectionOffset);
+    _readPoints(firstSectionOffset);
     _readPerimeters(firstSectionOffset);
     _readMitochondria();
+    _selectMitochondria();
+
+    if (_lazyPoints) {
+        _properties._pointLoader = std::make_shared<LazyPointLevel>(std::move(_file),
+            std::move(_lazyPoints),
+            std::move(_lazyPerimeters),
+            _pointRuns,
+            _lazySections);
+    }
 
     return _properties;
 }
@@ -90,6 +351,14 @@ MorphologyHDF5::~MorphologyHDF5()
 
 void MorphologyHDF5::_checkVersion(const std::string& source)
 {
+    // The cells of a container are stored in the version 1.1 layout
+    if (_cell) {
+        _properties._cellLevel._version = MORPHOLOGY_VERSION_H5_1_1;
+        _properties._cellLevel._cellFamily = _cell->family;
+        _resolveV1();
+        return;
+    }
+
     if (_readV11Metadata())
         return;
 
@@ -211,6 +480,26 @@ HighFive::DataSet MorphologyHDF5::_getStructureDataSet(size_t nSections)
 }
 
 
+size_t MorphologyHDF5::_firstPointRow() const
+{
+    return _cell ? _cell->firstPoint : 0;
+}
+
+size_t MorphologyHDF5::_pointRowCount(const HighFive::DataSet& points) const
+{
+    return _cell ? _cell->nPoints : points.getSpace().getDimensions()[0];
+}
+
+size_t MorphologyHDF5::_firstSectionRow() const
+{
+    return _cell ? _cell->firstSection : 0;
+}
+
+size_t MorphologyHDF5::_sectionRowCount() const
+{
+    return _cell ? _cell->nSections : _sectionsDims[0];
+}
+
 /**
    Returns true if the neuron has no neurites
 **/
@@ -220,6 +509,31 @@ static inline bool noNeurites(int firstSectionOffset)
 }
 
 
+HighFive::DataSet MorphologyHDF5::_getPointsDataSet()
+{
+    if (_properties.version() != MORPHOLOGY_VERSION_H5_2)
+        return *_points;
+
+    std::string path = "/" + _g_root + "/" + _stage + "/" + _d_points;
+    HighFive::DataSet dataset = [this, &path]() {
+        try {
+            return _file->getDataSet(path);
+        } catch (HighFive::DataSetException&) {
+            LBTHROW(MorphioError(
+                "Could not open " + path + " dataset for morphology file " + _file->getName() +
+                " repair stage " + _stage));
+        }
+    }();
+
+    const auto dims = dataset.getSpace().getDimensions();
+    if (dims.size() != 2 || dims[1] != _pointColumns) {
+        LBTHROW(MorphioError(
+            "Reading morphology file '" + _file->getName() +
+            "': bad number of dimensions in 'points' dataspace"));
+    }
+    return dataset;
+}
+
 void MorphologyHDF5::_readPoints(int firstSectionOffset)
 {
     auto& points = _properties.get<Property::Point>();
@@ -228,77 +542,39 @@ void MorphologyHDF5::_readPoints(int firstSectionOffset)
     auto& somaPoints = _properties._somaLevel._points;
     auto& somaDiameters = _properties._somaLevel._diameters;
 
-    if (_properties.version() == MORPHOLOGY_VERSION_H5_2) {
-        auto dataset = [this]() {
-            std::string path = "/" + _g_root + "/" + _stage + "/" + _d_points;
-            try {
-                return _file->getDataSet(path);
-            } catch (HighFive::DataSetException&) {
-                LBTHROW(MorphioError(
-                    "Could not open " + path + " dataset for morphology file " + _file->getName() +
-                    " repair stage " + _stage));
-            }
-        }();
-
-        const auto dims = dataset.getSpace().getDimensions();
-        if (dims.size() != 2 || dims[1] != _pointColumns) {
-            LBTHROW(MorphioError(
-                "Reading morphology file '" + _file->getName() +
-                "': bad number of dimensions in 'points' dataspace"));
-        }
-        std::vector<std::vector<float>> vec(dims[0]);
-        dataset.read(vec);
-
-        std::size_t offset = vec.size();
-        if (firstSectionOffset >= 0) {
-            offset = static_cast<size_t>(firstSectionOffset);
-        }
-
-        somaPoints.reserve(somaPoints.size() + offset);
-        somaDiameters.reserve(somaDiameters.size() + offset);
-        for (std::size_t i = 0; i < offset; ++i) {
-            const auto& p = vec[i];
-            somaPoints.emplace_back(Point{p[0], p[1], p[2]});
-            somaDiameters.emplace_back(p[3]);
-        }
+    const HighFive::DataSet dataset = _getPointsDataSet();
+    const size_t nRows = _pointRowCount(dataset);
 
-        if (!noNeurites(firstSectionOffset)) {
-            size_t size = (points.size() + vec.size() -
-                           static_cast<unsigned int>(firstSectionOffset));
-            points.reserve(size);
-            diameters.reserve(size);
-            for (std::size_t i = offset; i < vec.size(); ++i) {
-                const auto& p = vec[i];
-                points.emplace_back(Point{p[0], p[1], p[2]});
-                diameters.emplace_back(p[3]);
-            }
-        }
-        return;
+    std::size_t offset = nRows;
+    if (!noNeurites(firstSectionOffset)) {
+        offset = static_cast<size_t>(firstSectionOffset);
     }
 
-    std::vector<std::vector<float>> vec;
-    vec.resize(_pointsDims[0]);
-    _points->read(vec);
+    const size_t nSomaPoints = somaPoints.size();
+    somaPoints.resize(nSomaPoints + offset);
+    somaDiameters.resize(nSomaPoints + offset);
+    _readPointRows(dataset, _firstPointRow(), offset, somaPoints.data() + nSomaPoints,
+        somaDiameters.data() + nSomaPoints);
 
-    std::size_t offset = vec.size();
-    if (firstSectionOffset >= 0) {
-        offset = static_cast<unsigned int>(firstSectionOffset);
-    }
-
-    somaPoints.reserve(somaPoints.size() + offset);
-    somaDiameters.reserve(somaDiameters.size() + offset);
-    for (std::size_t i = 0; i < offset; ++i) {
-        const auto& p = vec[i];
-        somaPoints.emplace_back(Point{p[0], p[1], p[2]});
-        somaDiameters.emplace_back(p[3]);
+    // In lazy mode, only the soma points are read now
+    if (_lazy) {
+        if (!_pointRuns.empty())
+            _lazyPoints.reset(new HighFive::DataSet(dataset));
+        return;
     }
 
-    points.reserve(points.size() + vec.size() - offset);
-    diameters.reserve(diameters.size() + vec.size() - offset);
-    for (std::size_t i = offset; i < vec.size(); ++i) {
-        const auto& p = vec[i];
-        points.emplace_back(Point{p[0], p[1], p[2]});
-        diameters.emplace_back(p[3]);
+    size_t nPoints = points.size();
+    for (const auto& run : _pointRuns)
+        nPoints += run.second;
+    size_t start = points.size();
+    points.resize(nPoints);
+    diameters.resize(nPoints);
+
+    // Only the hyperslabs of the selected neurites are read
+    for (const auto& run : _pointRuns) {
+        _readPointRows(dataset, run.first, run.second, points.data() + start,
+            diameters.data() + start);
+        start += run.second;
     }
 }
 
@@ -342,45 +618,19 @@ int MorphologyHDF5::_readSections()
                 "': bad number of dimensions in 'structure' dataspace"));
         }
 
-        std::vector<std::vector<int>> vec;
-        vec.resize(dims[0] - 1);
-        dataset.read(vec);
-        int firstSectionOffset = vec[1][0];
-        sections.reserve(sections.size() + vec.size() - 1);
-        bool skipFirst = true;
-        for (const auto& p : vec) {
-            if (skipFirst) {
-                skipFirst = false;
-                continue;
-            }
-            sections.emplace_back(Property::Section::Type{p[0] - firstSectionOffset, p[1] - 1});
-        }
-
-        return firstSectionOffset;
+        std::vector<int> rows(dims[0] * _structureV2Columns);
+        if (!rows.empty())
+            dataset.read(rows.data());
+        return _appendSections(rows, sections, _file->getName());
     }
 
-    auto selection = _sections->select({0, 0}, {_sectionsDims[0], 2}, {1, 2});
-
-    std::vector<std::vector<int>> vec;
-    vec.resize(_sectionsDims[0]);
-    selection.read(vec);
+    // Only the offset and parent columns are read
+    auto selection = _sections->select({_firstSectionRow(), 0}, {_sectionRowCount(), 2}, {1, 2});
 
-    if (vec.size() < 2) // Neuron without any neurites
-        return -1;
-
-    int firstSectionOffset = vec[1][0];
-
-    sections.reserve(sections.size() + vec.size() - 1);
-    bool skipFirst = true; // Skipping soma section
-    for (const auto& p : vec) {
-        if (skipFirst) {
-            skipFirst = false;
-            continue;
-        }
-        sections.emplace_back(Property::Section::Type{p[0] - firstSectionOffset, p[1] - 1});
-    }
-
-    return firstSectionOffset;
+    std::vector<int> rows(_sectionRowCount() * 2);
+    if (!rows.empty())
+        selection.read(rows.data());
+    return _appendSections(rows, sections, _file->getName());
 }
 
 void MorphologyHDF5::_readSectionTypes()
@@ -416,8 +666,8 @@ void MorphologyHDF5::_readSectionTypes()
         return;
     }
 
-    auto selection = _sections->select({0, 1}, {_sectionsDims[0], 1});
-    types.resize(_sectionsDims[0]);
+    auto selection = _sections->select({_firstSectionRow(), 1}, {_sectionRowCount(), 1});
+    types.resize(_sectionRowCount());
     selection.read(types);
     types.erase(types.begin()); // remove soma type
     for (int type : types) {
@@ -428,10 +678,82 @@ void MorphologyHDF5::_readSectionTypes()
     }
 }
 
+/**
+   Compute the runs of points to read and, if sectionTypes is not empty, drop
+   the sections of the unselected neurites
+**/
+void MorphologyHDF5::_selectSections(int firstSectionOffset)
+{
+    if (noNeurites(firstSectionOffset))
+        return;
+
+    // The runs are rows of the whole dataset
+    const size_t offset = _firstPointRow() + static_cast<size_t>(firstSectionOffset);
+    const size_t nRows = _firstPointRow() + _pointRowCount(_getPointsDataSet());
+    if (_sectionTypes.empty()) {
+        if (nRows > offset)
+            _pointRuns.emplace_back(offset, nRows - offset);
+        return;
+    }
+
+    auto& sections = _properties.get<Property::Section>();
+    auto& types = _properties.get<Property::SectionType>();
+    const size_t nSections = sections.size();
+
+    // The type of a neurite is the type of its root section
+    std::vector<size_t> roots(nSections);
+    for (size_t i = 0; i < nSections; ++i) {
+        size_t root = i;
+        for (size_t depth = 0; sections[root][1] > -1; ++depth) {
+            const auto parent = static_cast<size_t>(sections[root][1]);
+            if (parent >= nSections || depth == nSections)
+                LBTHROW(morphio::RawDataError("Reading morphology file '" + _file->getName() +
+                                              "': invalid parent of section " +
+                                              std::to_string(root)));
+            if (parent < i) {
+                root = roots[parent];
+                break;
+            }
+            root = parent;
+        }
+        roots[i] = root;
+    }
+
+    std::vector<Property::Section::Type> selectedSections;
+    std::vector<SectionType> selectedTypes;
+    _sectionIds.assign(nSections, -1);
+    int nPoints = 0;
+    for (size_t i = 0; i < nSections; ++i) {
+        if (_sectionTypes.count(types[roots[i]]) == 0)
+            continue;
+
+        const size_t start = offset + static_cast<size_t>(sections[i][0]);
+        const size_t end = i + 1 < nSections ? offset + static_cast<size_t>(sections[i + 1][0])
+                                             : nRows;
+        _sectionIds[i] = static_cast<int>(selectedSections.size());
+        selectedSections.push_back({nPoints, sections[i][1]});
+        selectedTypes.push_back(types[i]);
+        nPoints += static_cast<int>(end - start);
+
+        if (!_pointRuns.empty() && _pointRuns.back().first + _pointRuns.back().second == start)
+            _pointRuns.back().second += end - start;
+        else if (end > start)
+            _pointRuns.emplace_back(start, end - start);
+    }
+
+    // The parent of a selected section belongs to the same neurite
+    for (auto& section : selectedSections)
+        if (section[1] > -1)
+            section[1] = _sectionIds[static_cast<size_t>(section[1])];
+
+    sections.swap(selectedSections);
+    types.swap(selectedTypes);
+}
 
 void MorphologyHDF5::_readPerimeters(int firstSectionOffset)
 {
-    if (_properties.version() != MORPHOLOGY_VERSION_H5_1_1 || noNeurites(firstSectionOffset))
+    if (_properties.version() != MORPHOLOGY_VERSION_H5_1_1 || noNeurites(firstSectionOffset) ||
+        (_cell && !_cell->hasPerimeters))
         return;
 
     try {
@@ -444,11 +766,18 @@ void MorphologyHDF5::_readPerimeters(int firstSectionOffset)
                                  "': bad number of dimensions in 'perimeters' dataspace"));
         }
 
-        std::vector<float> perimeters;
-        perimeters.resize(dims[0]);
-        dataset.read(perimeters);
-        _properties.get<Property::Perimeter>().assign(perimeters.begin() + firstSectionOffset,
-            perimeters.end());
+        if (_lazyPoints) {
+            _lazyPerimeters.reset(new HighFive::DataSet(dataset));
+            return;
+        }
+
+        auto& perimeters = _properties.get<Property::Perimeter>();
+        std::vector<float> run;
+        for (const auto& pointRun : _pointRuns) {
+            run.resize(pointRun.second);
+            dataset.select({pointRun.first}, {pointRun.second}).read(run);
+            perimeters.insert(perimeters.end(), run.begin(), run.end());
+        }
     } catch (...) {
         if (_properties._cellLevel._cellFamily == FAMILY_GLIA)
             LBTHROW(
@@ -461,7 +790,10 @@ template <typename T>
 void MorphologyHDF5::_read(const std::string& groupName,
     const std::string& _dataset,
     MorphologyVersion version,
-    unsigned int expectedDimension, T& data)
+    unsigned int expectedDimension,
+    size_t firstRow,
+    size_t nRows,
+    T& data)
 {
     if (_properties.version() != version)
         return;
@@ -476,8 +808,18 @@ void MorphologyHDF5::_read(const std::string& groupName,
                                  "': bad number of dimensions in 'perimeters' dataspace"));
         }
 
-        data.resize(dims[0]);
-        dataset.read(data);
+        // Read as a flat row major buffer of all the values of the rows
+        if (nRows == _allRows)
+            nRows = dims[0] - firstRow;
+        std::vector<size_t> offsets(dims.size(), 0);
+        offsets[0] = firstRow;
+        dims[0] = nRows;
+        size_t size = 1;
+        for (const size_t dim : dims)
+            size *= dim;
+        data.resize(size);
+        if (size > 0)
+            dataset.select(offsets, dims).read(data.data());
     } catch (...) {
         if (_properties._cellLevel._cellFamily == FAMILY_GLIA)
             LBTHROW(
@@ -498,29 +840,89 @@ void MorphologyHDF5::_readMitochondria()
         }
     }
 
-    std::vector<std::vector<float>> points;
-    _read(_g_mitochondria, _d_points, MORPHOLOGY_VERSION_H5_1_1, 2, points);
+    // Rows of (neurite section id, relative path length, diameter)
+    std::vector<float> points;
+    _read(_g_mitochondria, _d_points, MORPHOLOGY_VERSION_H5_1_1, 2,
+        _cell ? _cell->firstMitoPoint : 0, _cell ? _cell->nMitoPoints : _allRows, points);
+    const size_t nPoints = points.size() / 3;
 
     auto& mitoSectionId = _properties.get<Property::MitoNeuriteSectionId>();
     auto& pathlength = _properties.get<Property::MitoPathLength>();
     auto& diameters = _properties.get<Property::MitoDiameter>();
-    mitoSectionId.reserve(mitoSectionId.size() + points.size());
-    pathlength.reserve(pathlength.size() + points.size());
-    diameters.reserve(diameters.size() + points.size());
-    for (const auto& p : points) {
-        mitoSectionId.push_back(static_cast<uint32_t>(p[0]));
-        pathlength.push_back(p[1]);
-        diameters.push_back(p[2]);
+    mitoSectionId.reserve(mitoSectionId.size() + nPoints);
+    pathlength.reserve(pathlength.size() + nPoints);
+    diameters.reserve(diameters.size() + nPoints);
+    for (size_t i = 0; i < nPoints; ++i) {
+        mitoSectionId.push_back(static_cast<uint32_t>(points[3 * i]));
+        pathlength.push_back(points[3 * i + 1]);
+        diameters.push_back(points[3 * i + 2]);
     }
 
-    std::vector<std::vector<int32_t>> structure;
+    // Rows of (offset, parent)
+    std::vector<int32_t> structure;
     _read(_g_mitochondria, "structure", MORPHOLOGY_VERSION_H5_1_1, 2,
-        structure);
+        _cell ? _cell->firstMitoSection : 0, _cell ? _cell->nMitoSections : _allRows, structure);
 
     auto& mitoSection = _properties.get<Property::MitoSection>();
-    mitoSection.reserve(mitoSection.size() + structure.size());
-    for (auto& s : structure)
-        mitoSection.emplace_back(Property::MitoSection::Type{s[0], s[1]});
+    mitoSection.reserve(mitoSection.size() + structure.size() / 2);
+    for (size_t i = 0; i + 1 < structure.size(); i += 2)
+        mitoSection.emplace_back(Property::MitoSection::Type{structure[i], structure[i + 1]});
+}
+
+/**
+   Drop the mitochondria lying on the unselected neurites and renumber the
+   neurite sections of the other ones
+**/
+void MorphologyHDF5::_selectMitochondria()
+{
+    if (_sectionIds.empty())
+        return;
+
+    auto& mitoSections = _properties.get<Property::MitoSection>();
+    auto& mitoSectionIds = _properties.get<Property::MitoNeuriteSectionId>();
+    auto& pathlengths = _properties.get<Property::MitoPathLength>();
+    auto& diameters = _properties.get<Property::MitoDiameter>();
+    const size_t nPoints = mitoSectionIds.size();
+
+    auto isSelected = [this](uint32_t sectionId) {
+        return sectionId < _sectionIds.size() && _sectionIds[sectionId] > -1;
+    };
+
+    std::vector<int> newIds(mitoSections.size(), -1);
+    std::vector<Property::MitoSection::Type> selectedSections;
+    std::vector<Property::MitoNeuriteSectionId::Type> selectedSectionIds;
+    std::vector<Property::MitoPathLength::Type> selectedPathlengths;
+    std::vector<Property::MitoDiameter::Type> selectedDiameters;
+    for (size_t i = 0; i < mitoSections.size(); ++i) {
+        const auto start = static_cast<size_t>(mitoSections[i][0]);
+        const size_t end = i + 1 < mitoSections.size()
+                               ? static_cast<size_t>(mitoSections[i + 1][0])
+                               : nPoints;
+        if (start >= end || end > nPoints ||
+            !std::all_of(mitoSectionIds.begin() + static_cast<std::ptrdiff_t>(start),
+                mitoSectionIds.begin() + static_cast<std::ptrdiff_t>(end),
+                isSelected))
+            continue;
+
+        newIds[i] = static_cast<int>(selectedSections.size());
+        selectedSections.push_back({static_cast<int>(selectedSectionIds.size()), mitoSections[i][1]});
+        for (size_t j = start; j < end; ++j) {
+            selectedSectionIds.push_back(static_cast<uint32_t>(_sectionIds[mitoSectionIds[j]]));
+            selectedPathlengths.push_back(pathlengths[j]);
+            selectedDiameters.push_back(diameters[j]);
+        }
+    }
+
+    // A mitochondrion lies on a single neurite so the parent of a selected
+    // section is selected
+    for (auto& section : selectedSections)
+        if (section[1] > -1)
+            section[1] = newIds[static_cast<size_t>(section[1])];
+
+    mitoSections.swap(selectedSections);
+    mitoSectionIds.swap(selectedSectionIds);
+    pathlengths.swap(selectedPathlengths);
+    diameters.swap(selectedDiameters);
 }
 
 } // namespace h5
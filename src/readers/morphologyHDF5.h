@@ -1,5 +1,6 @@
 #pragma once
 #include <memory> // std::unique_ptr
+#include <set>    // std::set
 #include <string> // std::string
 #include <vector> // std::vector
 
@@ -13,33 +14,88 @@
 namespace morphio {
 namespace readers {
 namespace h5 {
-Property::Properties load(const URI& uri);
+/**
+   Only the points of the neurites whose root section has one of the given
+   sectionTypes are read, an empty set reads all of them
+**/
+Property::Properties load(const URI& uri,
+    unsigned int options = NO_MODIFIER,
+    const std::set<SectionType>& sectionTypes = {});
+
+/**
+   Parse the image of an HDF5 file held in memory, uri is only used in error
+   messages
+**/
+Property::Properties load(const URI& uri,
+    const char* image,
+    size_t size,
+    const std::set<SectionType>& sectionTypes = {});
+
+/**
+   The rows of one morphology in the datasets of an HDF5 file of version 1.1:
+   all the rows for a morphology file, the rows of one cell for a container
+   (see morphio::Container)
+**/
+struct CellRows
+{
+    size_t firstPoint = 0;
+    size_t nPoints = 0;
+    size_t firstSection = 0;
+    size_t nSections = 0;
+    size_t firstMitoPoint = 0;
+    size_t nMitoPoints = 0;
+    size_t firstMitoSection = 0;
+    size_t nMitoSections = 0;
+    CellFamily family = FAMILY_NEURON;
+    bool hasPerimeters = false;
+};
 
 class MorphologyHDF5
 {
 public:
-    MorphologyHDF5(const std::string& uri) : _err(uri), _uri(uri){}
+    MorphologyHDF5(const std::string& uri, const std::set<SectionType>& sectionTypes = {})
+        : _sectionTypes(sectionTypes), _err(uri), _uri(uri){}
     virtual ~MorphologyHDF5();
-    Property::Properties load();
+    /**
+       Only the LAZY_LOAD and LAZY_LOAD_SECTIONS options are used, modifiers
+       are applied by the caller
+    **/
+    Property::Properties load(unsigned int options = NO_MODIFIER);
+    Property::Properties load(const char* image, size_t size);
+    /**
+       Read only the given rows of the already opened file
+    **/
+    Property::Properties load(const HighFive::File& file, const CellRows& cell, unsigned int options);
 
 private:
+    Property::Properties _load();
     void _checkVersion(const std::string& source);
     void _selectRepairStage();
     void _resolveV1();
     bool _readV11Metadata();
     bool _readV2Metadata();
     HighFive::DataSet _getStructureDataSet(size_t nSections);
+    HighFive::DataSet _getPointsDataSet();
     void _readPoints(int);
     int _readSections();
     void _readSectionTypes();
+    void _selectSections(int);
+    void _selectMitochondria();
     void _readPerimeters(int);
     void _readMitochondria();
 
+    size_t _firstPointRow() const;
+    size_t _pointRowCount(const HighFive::DataSet& points) const;
+    size_t _firstSectionRow() const;
+    size_t _sectionRowCount() const;
+
     template <typename T>
     void _read(const std::string& group,
                const std::string& _dataset,
                MorphologyVersion version,
                unsigned int expectedDimension,
+               size_t firstRow,
+               size_t nRows,
                T& data);
 
     std::unique_ptr<HighFive::File> _file;
@@ -50,6 +106,22 @@ private:
     std::unique_ptr<HighFive::DataSet> _sections;
     std::vector<size_t> _sectionsDims;
 
+    // Lazy mode: the datasets read on first access
+    bool _lazy = false;
+    bool _lazySections = false;
+    std::unique_ptr<HighFive::DataSet> _lazyPoints;
+    std::unique_ptr<HighFive::DataSet> _lazyPerimeters;
+
+    // The neurites to read, and once the sections are selected, the
+    // (first row, number of rows) runs of their points in the file and the
+    // new id of every section of the file (-1 when it is skipped)
+    std::set<SectionType> _sectionTypes;
+    std::vector<std::pair<size_t, size_t>> _pointRuns;
+    std::vector<int> _sectionIds;
+
+    // The rows of the cell of a container, nullptr for a morphology file
+    const CellRows* _cell = nullptr;
+
     std::string _stage;
     Property::Properties _properties;
     bool _write;
@@ -1,25 +1,181 @@
 #include "morphologySWC.h"
 
-#include <cstdint> // uint32_t
-#include <fstream>
-#include <map> // std::map
-#include <memory> // std::shared_ptr
-#include <string> // std::string
-#include <vector> // std::vector
+#include "../propertiesModifiers.h"
+#include "memoryMap.h"
+#include "parseNumber.h"
+
+#include <algorithm>     // std::sort
+#include <cstdint>       // uint32_t
+#include <cstring>       // memchr
+#include <limits>        // std::numeric_limits
+#include <memory>        // std::shared_ptr
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map
+#include <utility>       // std::pair
+#include <vector>        // std::vector
 
 #include <morphio/errorMessages.h>
-#include <morphio/mut/morphology.h>
-#include <morphio/mut/section.h>
-#include <morphio/mut/soma.h>
 #include <morphio/properties.h>
 
 namespace {
-bool _ignoreLine(const std::string& line)
+// The white spaces of sscanf in the "C" locale
+inline bool _isSpace(char c)
 {
-    std::size_t pos = line.find_first_not_of("\n\r\t ");
-    return pos == std::string::npos || line[pos] == '#';
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
 }
 
+inline const char* _skipSpaces(const char* it, const char* end)
+{
+    while (it != end && _isSpace(*it))
+        ++it;
+    return it;
+}
+
+inline const char* _tokenEnd(const char* it, const char* end)
+{
+    while (it != end && !_isSpace(*it))
+        ++it;
+    return it;
+}
+
+/**
+   Parse the integer at the start of [begin, end)
+
+   A fractional part made of zeros is accepted as some tools write the ids
+   as floats. Return the end of the integer or nullptr if there is none.
+**/
+template <typename T>
+const char* _parseInteger(const char* begin, const char* end, T& value)
+{
+    const char* it = begin;
+    bool negative = false;
+    if (it != end && (*it == '+' || *it == '-'))
+        negative = *it++ == '-';
+    if (it == end || !morphio::readers::isDigit(*it))
+        return nullptr;
+
+    int64_t result = 0;
+    for (; it != end && morphio::readers::isDigit(*it); ++it) {
+        result = result * 10 + (*it - '0');
+        if (result > std::numeric_limits<uint32_t>::max())
+            return nullptr;
+    }
+    if (it != end && *it == '.')
+        for (++it; it != end && *it == '0'; ++it) {
+        }
+
+    if (negative)
+        result = -result;
+    if (result < std::numeric_limits<T>::min() || result > std::numeric_limits<T>::max())
+        return nullptr;
+    value = static_cast<T>(result);
+    return it;
+}
+
+/**
+   Parse the 7 fields of the sample line [it, end), what follows the leading
+   integer of the last field is ignored like sscanf did
+**/
+bool _parseSample(const char* it, const char* end, morphio::readers::Sample& sample)
+{
+    const size_t nFields = 7;
+    std::pair<const char*, const char*> fields[nFields];
+    for (auto& field : fields) {
+        field.first = _skipSpaces(it, end);
+        field.second = it = _tokenEnd(field.first, end);
+        if (field.first == field.second)
+            return false;
+    }
+
+    int type;
+    float radius;
+    if (_parseInteger(fields[0].first, fields[0].second, sample.id) != fields[0].second ||
+        _parseInteger(fields[1].first, fields[1].second, type) != fields[1].second ||
+        !morphio::readers::parseFloat(fields[2].first, fields[2].second, sample.point[0]) ||
+        !morphio::readers::parseFloat(fields[3].first, fields[3].second, sample.point[1]) ||
+        !morphio::readers::parseFloat(fields[4].first, fields[4].second, sample.point[2]) ||
+        !morphio::readers::parseFloat(fields[5].first, fields[5].second, radius) ||
+        _parseInteger(fields[6].first, fields[6].second, sample.parentId) == nullptr)
+        return false;
+
+    sample.type = static_cast<morphio::SectionType>(type);
+    sample.diameter = radius * 2; // The point array stores diameters.
+    sample.valid = true;
+    return true;
+}
+
+/**
+   Position of each SWC id in the sample vector
+
+   Ids are usually numbered from 1 without gaps, they then index a vector.
+   Once an id is too large compared to the number of samples, the index falls
+   back to a hash map.
+**/
+class SampleIndex
+{
+public:
+    static const uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    uint32_t find(uint32_t id) const
+    {
+        if (!_isSparse)
+            return id < _dense.size() ? _dense[id] : none;
+        const auto it = _sparse.find(id);
+        return it == _sparse.end() ? none : it->second;
+    }
+
+    void insert(uint32_t id, uint32_t position)
+    {
+        if (!_isSparse && id >= _dense.size()) {
+            if (id / 4 <= position + 1024)
+                _dense.resize(id + 1, none);
+            else
+                _makeSparse();
+        }
+
+        if (_isSparse)
+            _sparse[id] = position;
+        else
+            _dense[id] = position;
+    }
+
+    /**
+       Call function with the positions of the samples in increasing id order
+    **/
+    template <typename Function>
+    void forEachById(Function function) const
+    {
+        if (!_isSparse) {
+            for (uint32_t position : _dense)
+                if (position != none)
+                    function(position);
+            return;
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> ids(_sparse.begin(), _sparse.end());
+        std::sort(ids.begin(), ids.end());
+        for (const auto& id : ids)
+            function(id.second);
+    }
+
+private:
+    void _makeSparse()
+    {
+        _sparse.reserve(_dense.size());
+        for (uint32_t id = 0; id < _dense.size(); ++id)
+            if (_dense[id] != none)
+                _sparse[id] = _dense[id];
+        std::vector<uint32_t>().swap(_dense);
+        _isSparse = true;
+    }
+
+    bool _isSparse = false;
+    std::vector<uint32_t> _dense;
+    std::unordered_map<uint32_t, uint32_t> _sparse;
+};
+
+const uint32_t SampleIndex::none;
+
 } // unnamed namespace
 
 namespace morphio {
@@ -35,37 +191,35 @@ const int SWC_UNDEFINED_PARENT = -1;
 class SWCBuilder
 {
 public:
-    explicit SWCBuilder(const std::string& _uri)
+    SWCBuilder(const std::string& _uri, const char* data, size_t size)
     : uri(_uri)
     , err(_uri)
-    , debugInfo(_uri)
     {
-        _readSamples();
+        _readSamples(data, size);
+        _buildChildren();
 
-        for (auto sample_pair : samples) {
-            const auto& sample = sample_pair.second;
-            raiseIfNonConform(sample);
-        }
+        index.forEachById([this](uint32_t position) { raiseIfNonConform(samples[position]); });
 
         checkSoma();
     }
 
-    void _readSamples()
+    void _readSamples(const char* data, size_t size)
     {
-        std::ifstream file(uri.c_str());
-        if (file.fail())
-            LBTHROW(morphio::RawDataError(err.ERROR_OPENING_FILE()));
-
         unsigned int lineNumber = 0;
-        std::string line;
-        while (!std::getline(file, line).fail()) {
+        const char* end = data + size;
+        for (const char* begin = data; begin < end;) {
+            const void* newLine = memchr(begin, '\n', static_cast<size_t>(end - begin));
+            const char* lineEnd = newLine != nullptr ? static_cast<const char*>(newLine) : end;
+            const char* first = _skipSpaces(begin, lineEnd);
+            begin = lineEnd + 1;
             ++lineNumber;
 
-            if (line.empty() || _ignoreLine(line))
+            if (first == lineEnd || *first == '#')
                 continue;
 
-            const auto& sample = Sample(line.data(), lineNumber);
-            if (!sample.valid)
+            Sample sample;
+            sample.lineNumber = lineNumber;
+            if (!_parseSample(first, lineEnd, sample))
                 LBTHROW(morphio::RawDataError(
                             err.ERROR_LINE_NON_PARSABLE(lineNumber)));
 
@@ -73,18 +227,74 @@ public:
                 LBTHROW(morphio::RawDataError(
                             err.ERROR_UNSUPPORTED_SECTION_TYPE(lineNumber, sample.type)));
 
-            if (samples.count(sample.id) > 0)
+            const uint32_t position = index.find(sample.id);
+            if (position != SampleIndex::none)
                 LBTHROW(morphio::RawDataError(
-                    err.ERROR_REPEATED_ID(samples[sample.id], sample)));
+                    err.ERROR_REPEATED_ID(samples[position], sample)));
 
-            samples[sample.id] = sample;
-            children[sample.parentId].push_back(sample.id);
+            index.insert(sample.id, static_cast<uint32_t>(samples.size()));
+            samples.push_back(sample);
 
             if (sample.type == SECTION_SOMA) {
                 lastSomaPoint = static_cast<int>(sample.id);
             }
         }
-        file.close();
+    }
+
+    /**
+       Group the sample positions by parent, in file order, the children of
+       the samples with parentId == -1 come first
+    **/
+    void _buildChildren()
+    {
+        std::vector<uint32_t> slots(samples.size());
+        childOffsets.assign(samples.size() + 2, 0);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            slots[i] = _childSlot(samples[i].parentId);
+            if (slots[i] != SampleIndex::none)
+                ++childOffsets[slots[i] + 1];
+        }
+
+        for (size_t i = 1; i < childOffsets.size(); ++i)
+            childOffsets[i] += childOffsets[i - 1];
+        childPositions.resize(childOffsets.back());
+        std::vector<uint32_t> cursors(childOffsets.begin(), childOffsets.end() - 1);
+        for (size_t i = 0; i < samples.size(); ++i)
+            if (slots[i] != SampleIndex::none)
+                childPositions[cursors[slots[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    uint32_t _childSlot(int32_t id) const
+    {
+        if (id == SWC_UNDEFINED_PARENT)
+            return 0;
+        if (id < 0)
+            return SampleIndex::none;
+        const uint32_t position = index.find(static_cast<uint32_t>(id));
+        return position == SampleIndex::none ? position : position + 1;
+    }
+
+    /**
+       The positions of the children of the sample with the given id
+    **/
+    range<const uint32_t> _children(int32_t id) const
+    {
+        const uint32_t slot = _childSlot(id);
+        if (slot == SampleIndex::none)
+            return range<const uint32_t>();
+        return range<const uint32_t>(childPositions.data() + childOffsets[slot],
+            childPositions.data() + childOffsets[slot + 1]);
+    }
+
+    /**
+       The sample with the given id, or an undefined sample if there is none
+    **/
+    const Sample& _sample(int32_t id) const
+    {
+        static const Sample undefined;
+        const uint32_t position = id < 0 ? SampleIndex::none
+                                         : index.find(static_cast<uint32_t>(id));
+        return position == SampleIndex::none ? undefined : samples[position];
     }
 
     /**
@@ -94,9 +304,9 @@ public:
     std::vector<Sample> _potentialSomata()
     {
         std::vector<Sample> somata;
-        for (auto id : children[-1]) {
-            if (samples[id].type == SECTION_SOMA)
-                somata.push_back(samples[id]);
+        for (auto position : _children(SWC_UNDEFINED_PARENT)) {
+            if (samples[position].type == SECTION_SOMA)
+                somata.push_back(samples[position]);
         }
         return somata;
     }
@@ -106,13 +316,14 @@ public:
         if (sample.type != SECTION_SOMA)
             return;
 
-        if (sample.parentId != -1 && !children[static_cast<int>(sample.id)].empty()) {
+        const auto children = _children(static_cast<int>(sample.id));
+        if (sample.parentId != -1 && !children.empty()) {
             std::vector<Sample> soma_bifurcations;
-            for (auto id : children[static_cast<int>(sample.id)]) {
-                if (samples[id].type == SECTION_SOMA)
-                    soma_bifurcations.push_back(samples[id]);
+            for (auto position : children) {
+                if (samples[position].type == SECTION_SOMA)
+                    soma_bifurcations.push_back(samples[position]);
                 else
-                    neurite_wrong_root.push_back(samples[id]);
+                    neurite_wrong_root.push_back(samples[position]);
             }
 
             if (soma_bifurcations.size() > 1)
@@ -120,7 +331,7 @@ public:
                     err.ERROR_SOMA_BIFURCATION(sample, soma_bifurcations)));
         }
 
-        if (sample.parentId != -1 && samples[static_cast<unsigned int>(sample.parentId)].type != SECTION_SOMA)
+        if (sample.parentId != -1 && _sample(sample.parentId).type != SECTION_SOMA)
             LBTHROW(
                 morphio::SomaError(err.ERROR_SOMA_WITH_NEURITE_PARENT(sample)));
     }
@@ -151,7 +362,7 @@ public:
 
     void raiseIfNoParent(const Sample& sample)
     {
-        if (sample.parentId > -1 && samples.count(static_cast<unsigned int>(sample.parentId)) == 0)
+        if (sample.parentId > -1 && index.find(static_cast<unsigned int>(sample.parentId)) == SampleIndex::none)
             LBTHROW(
                 morphio::MissingParentError(err.ERROR_MISSING_PARENT(sample)));
     }
@@ -168,38 +379,66 @@ public:
     {
         return isOrphanNeurite(sample) ||
                (sample.type != SECTION_SOMA &&
-                   samples[static_cast<unsigned int>(sample.parentId)].type == SECTION_SOMA); // Exclude soma bifurcations
+                   _sample(sample.parentId).type == SECTION_SOMA); // Exclude soma bifurcations
     }
 
     inline bool isSectionStart(const Sample& sample)
     {
-        return (isRootPoint(sample) || (sample.parentId > -1 && isSectionEnd(samples[static_cast<unsigned int>(sample.parentId)]))); // Standard section
+        return (isRootPoint(sample) || (sample.parentId > -1 && isSectionEnd(_sample(sample.parentId)))); // Standard section
     }
 
     inline bool isSectionEnd(const Sample& sample)
     {
         int id = static_cast<int>(sample.id);
-        return id == lastSomaPoint ||       // End of soma
-               children[id].empty() ||      // Reached leaf
-               (children[id].size() >= 2 && // Reached neurite
+        const size_t nChildren = _children(id).size();
+        return id == lastSomaPoint || // End of soma
+               nChildren == 0 ||      // Reached leaf
+               (nChildren >= 2 &&     // Reached neurite
                    // bifurcation
                    sample.type != SECTION_SOMA);
     }
 
-    template <typename T>
-    void appendSample(std::shared_ptr<T> somaOrSection, const Sample& sample)
+    /**
+       Is position the root of a neurite whose type is not in sectionTypes
+    **/
+    bool _isSkipped(uint32_t position, const Sample* parent, const std::set<SectionType>& sectionTypes)
     {
-        debugInfo.setLineNumber(sample.id, sample.lineNumber);
-        somaOrSection->points().push_back(sample.point);
-        somaOrSection->diameters().push_back(sample.diameter);
+        const Sample& child = samples[position];
+        return !sectionTypes.empty() && child.type != SECTION_SOMA &&
+               (parent == nullptr || parent->type == SECTION_SOMA) &&
+               sectionTypes.count(child.type) == 0;
     }
 
-    void _pushChildren(std::vector<unsigned int>& vec, int32_t id)
+    /**
+       The sample positions in depth first order, skipping the neurites whose
+       root type is not in sectionTypes
+
+       An explicit stack is used as a single neurite can hold millions of
+       samples.
+    **/
+    std::vector<uint32_t> _depthFirstSamples(const std::set<SectionType>& sectionTypes)
     {
-        for (unsigned int childId : children[id]) {
-            vec.push_back(childId);
-            _pushChildren(vec, static_cast<int>(childId));
+        std::vector<uint32_t> positions;
+        positions.reserve(samples.size());
+        std::vector<uint32_t> stack;
+
+        auto pushChildren = [&](int32_t id, const Sample* parent) {
+            const auto children = _children(id);
+            for (auto it = children.end(); it != children.begin();) {
+                --it;
+                if (!_isSkipped(*it, parent, sectionTypes))
+                    stack.push_back(*it);
+            }
+        };
+
+        pushChildren(SWC_UNDEFINED_PARENT, nullptr);
+        while (!stack.empty()) {
+            const uint32_t position = stack.back();
+            stack.pop_back();
+            positions.push_back(position);
+            pushChildren(static_cast<int>(samples[position].id), &samples[position]);
         }
+        return positions;
     }
 
     void raiseIfNonConform(const Sample& sample)
@@ -240,9 +479,9 @@ public:
         }
     }
 
-    SomaType somaType()
+    SomaType somaType(const Property::PointLevel& soma)
     {
-        switch (morph.soma()->points().size()) {
+        switch (soma._points.size()) {
         case 0: {
             return SOMA_UNDEFINED;
         }
@@ -255,13 +494,12 @@ public:
         // NeuroMorpho format is characterized by a 3 points soma
         // with a bifurcation at soma root
         case 3: {
-            uint32_t somaRootId = children[-1][0];
-            auto& somaChildren = children[static_cast<int>(somaRootId)];
+            const Sample& somaRoot = samples[_children(SWC_UNDEFINED_PARENT)[0]];
 
             std::vector<Sample> children_soma_points;
-            for (auto child : somaChildren) {
-                if (this->samples[child].type == SECTION_SOMA)
-                    children_soma_points.push_back(this->samples[child]);
+            for (auto child : _children(static_cast<int>(somaRoot.id))) {
+                if (samples[child].type == SECTION_SOMA)
+                    children_soma_points.push_back(samples[child]);
             }
 
             if (children_soma_points.size() == 2) {
@@ -272,8 +510,7 @@ public:
                 //   http://neuromorpho.org/SomaFormat.html
 
                 if (!ErrorMessages::isIgnored(Warning::SOMA_NON_CONFORM))
-                    _checkNeuroMorphoSoma(this->samples[somaRootId],
-                        children_soma_points);
+                    _checkNeuroMorphoSoma(somaRoot, children_soma_points);
 
                 return SOMA_NEUROMORPHO_THREE_POINT_CYLINDERS;
             }
@@ -284,48 +521,55 @@ public:
         }
     }
 
-    Property::Properties _buildProperties(unsigned int options)
+    /**
+       Fill the flat arrays in a single depth first pass over the samples
+
+       The sections are emitted in the order mut::Morphology would create
+       them, so that modifiers::apply merges the unifurcations and applies the
+       modifiers as mut::Morphology::sanitize and applyModifiers would.
+    **/
+    Property::Properties _buildProperties(unsigned int options,
+        const std::set<SectionType>& sectionTypes)
     {
-        // The process might occasionally creates empty section before
-        // filling them so the warning is ignored
-        bool originalIsIgnored = err.isIgnored(morphio::Warning::APPENDING_EMPTY_SECTION);
-        set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, true);
+        Property::Properties properties;
+        auto& soma = properties._somaLevel;
+        auto& points = properties._pointLevel;
 
-        std::vector<unsigned int> depthFirstSamples;
-        _pushChildren(depthFirstSamples, -1);
-        for (const auto id : depthFirstSamples) {
-            const Sample& sample = samples[id];
+        sampleSections.assign(samples.size(), SampleIndex::none);
+        const auto depthFirstSamples = _depthFirstSamples(sectionTypes);
+        points._points.reserve(depthFirstSamples.size());
+        points._diameters.reserve(depthFirstSamples.size());
+
+        for (const auto position : depthFirstSamples) {
+            const Sample& sample = samples[position];
+
+            if (sample.type == SECTION_SOMA) {
+                soma._points.push_back(sample.point);
+                soma._diameters.push_back(sample.diameter);
+                continue;
+            }
 
             // Bifurcation right at the start
             if (isRootPoint(sample) && isSectionEnd(sample)) {
                 continue;
             }
 
-            if (isSectionStart(sample)) {
-                _processSectionStart(sample);
-            } else if (sample.type != SECTION_SOMA) {
-                swcIdToSectionId[sample.id] = swcIdToSectionId[static_cast<unsigned int>(sample.parentId)];
-            }
+            // The samples of a section are contiguous in depth first order
+            if (isSectionStart(sample))
+                _processSectionStart(position, properties);
+            else
+                sampleSections[position] = sampleSections[index.find(static_cast<unsigned int>(sample.parentId))];
 
-            if (sample.type == SECTION_SOMA) {
-                appendSample(morph.soma(), sample);
-            } else {
-                appendSample(morph.section(swcIdToSectionId.at(sample.id)),
-                    sample);
-            }
+            points._points.push_back(sample.point);
+            points._diameters.push_back(sample.diameter);
         }
 
-        if (morph.soma()->points().size() == 3 && !neurite_wrong_root.empty())
+        if (soma._points.size() == 3 && !neurite_wrong_root.empty())
             LBERROR(morphio::WRONG_ROOT_POINT,
                 err.WARNING_WRONG_ROOT_POINT(neurite_wrong_root));
 
-        morph.sanitize();
-        morph.applyModifiers(options);
-
-        Property::Properties properties = morph.buildReadOnly();
-        properties._cellLevel._somaType = somaType();
-
-        set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, originalIsIgnored);
+        modifiers::apply(properties, options);
+        properties._cellLevel._somaType = somaType(soma);
 
         return properties;
     }
@@ -335,59 +579,85 @@ public:
     section
        - Update the parent ID of the new section
     **/
-    void _processSectionStart(const Sample& sample)
+    void _processSectionStart(uint32_t position, Property::Properties& properties)
     {
-        Property::PointLevel properties;
-
-        uint32_t id = 0;
+        const Sample& sample = samples[position];
+        auto& sections = properties._sectionLevel._sections;
+        auto& points = properties._pointLevel;
 
-        if (isRootPoint(sample)) {
-            id = morph.appendRootSection(properties, sample.type)->id();
-        } else {
+        int32_t parentSection = -1;
+        const Sample* duplicate = nullptr;
+        if (!isRootPoint(sample)) {
             // Duplicating last point of previous section if there is not already a duplicate
-            auto parentId = static_cast<unsigned int>(sample.parentId);
-            if (sample.point != samples[parentId].point) {
-                properties._points.push_back(samples[parentId].point);
-                properties._diameters.push_back(samples[parentId].diameter);
-            }
+            const uint32_t parentPosition = index.find(static_cast<unsigned int>(sample.parentId));
+            const Sample& parent = samples[parentPosition];
+            if (sample.point != parent.point)
+                duplicate = &parent;
 
             // Handle the case, bifurcatation at root point
-            if (isRootPoint(samples[parentId])) {
-                id = morph.appendRootSection(properties, sample.type)->id();
-            } else {
-                id = morph.section(swcIdToSectionId[parentId])
-                    ->appendSection(properties, sample.type)
-                    ->id();
-            }
+            if (!isRootPoint(parent))
+                parentSection = static_cast<int32_t>(sampleSections[parentPosition]);
         }
 
-        swcIdToSectionId[sample.id] = id;
+        sampleSections[position] = static_cast<uint32_t>(sections.size());
+        sections.push_back({static_cast<int>(points._points.size()), parentSection});
+        properties._sectionLevel._sectionTypes.push_back(sample.type);
+
+        if (duplicate != nullptr) {
+            points._points.push_back(duplicate->point);
+            points._diameters.push_back(duplicate->diameter);
+        }
     }
 
 private:
-    // Dictionary: SWC Id of the last point of a section to morphio::mut::Section ID
-    std::map<uint32_t, uint32_t> swcIdToSectionId;
+    // The section of each sample, by position
+    std::vector<uint32_t> sampleSections;
 
     // Neurite that do not have parent ID = 1, allowed for soma contour, not
     // 3-pts soma
     std::vector<Sample> neurite_wrong_root;
 
     int lastSomaPoint = -1;
-    std::map<int32_t, std::vector<uint32_t>> children;
-    std::map<uint32_t, Sample> samples;
-    mut::Morphology morph;
+    // The samples in file order, index gives the position of an SWC id
+    std::vector<Sample> samples;
+    SampleIndex index;
+    // The children positions of each sample in CSR form, see _buildChildren
+    std::vector<uint32_t> childOffsets;
+    std::vector<uint32_t> childPositions;
     std::string uri;
     ErrorMessages err;
-    DebugInfo debugInfo;
 };
 
-Property::Properties load(const URI& uri, unsigned int options)
+namespace {
+Property::Properties _load(const URI& uri,
+    const char* data,
+    size_t size,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
 {
-    auto properties = SWCBuilder(uri)._buildProperties(options);
+    auto properties = SWCBuilder(uri, data, size)._buildProperties(options, sectionTypes);
     properties._cellLevel._cellFamily = FAMILY_NEURON;
     properties._cellLevel._version = MORPHOLOGY_VERSION_SWC_1;
     return properties;
 }
+} // namespace
+
+Property::Properties load(const URI& uri,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+{
+    const MemoryMap map(uri);
+    return _load(uri, map.data(), map.size(), options, sectionTypes);
+}
+
+Property::Properties load(const URI& uri,
+    const char* data,
+    size_t size,
+    unsigned int options,
+    const std::set<SectionType>& sectionTypes)
+{
+    return _load(uri, data, size, options, sectionTypes);
+}
 
 } // namespace swc
 } // namespace readers
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint> // uint64_t
+#include <cstdlib> // strtof
+#include <string>  // std::string
+
+namespace morphio {
+namespace readers {
+namespace detail {
+// The powers of ten exactly representable by a float
+const float pow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+const int maxPow10 = 10;
+// Any integer up to 2^24 is exactly representable by a float
+const uint64_t maxExactMantissa = 1 << 24;
+const int maxMantissaDigits = 19;
+
+inline bool parseFloatSlow(const char* begin, const char* end, float& value)
+{
+    const std::string token(begin, end);
+    char* last = nullptr;
+    value = strtof(token.c_str(), &last);
+    return !token.empty() && last == token.c_str() + token.size();
+}
+} // namespace detail
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+   Parse the whole token [begin, end) as a float, without allocating for
+   the usual decimal numbers
+
+   When both the decimal mantissa and the power of ten are exact floats, a
+   single multiplication or division gives the correctly rounded result, the
+   same as strtof. The other numbers are handed to strtof.
+**/
+inline bool parseFloat(const char* begin, const char* end, float& value)
+{
+    const char* it = begin;
+    bool negative = false;
+    if (it != end && (*it == '+' || *it == '-'))
+        negative = *it++ == '-';
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    for (; it != end && isDigit(*it); ++it, ++digits)
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*it - '0');
+    if (it != end && *it == '.')
+        for (++it; it != end && isDigit(*it); ++it, ++digits, --exponent)
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*it - '0');
+
+    if (it != end && (*it == 'e' || *it == 'E') && digits > 0) {
+        ++it;
+        bool negativeExponent = false;
+        if (it != end && (*it == '+' || *it == '-'))
+            negativeExponent = *it++ == '-';
+        if (it == end || !isDigit(*it))
+            return detail::parseFloatSlow(begin, end, value);
+        int power = 0;
+        for (; it != end && isDigit(*it) && power <= detail::maxPow10; ++it)
+            power = power * 10 + (*it - '0');
+        exponent += negativeExponent ? -power : power;
+    }
+
+    if (it != end || digits == 0 || digits > detail::maxMantissaDigits ||
+        mantissa > detail::maxExactMantissa || exponent < -detail::maxPow10 ||
+        exponent > detail::maxPow10)
+        return detail::parseFloatSlow(begin, end, value);
+
+    float result = static_cast<float>(mantissa);
+    result = exponent < 0 ? result / detail::pow10[-exponent] : result * detail::pow10[exponent];
+    value = negative ? -result : result;
+    return true;
+}
+} // namespace readers
+} // namespace morphio
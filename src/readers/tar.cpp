@@ -0,0 +1,212 @@
+#include "tar.h"
+
+#include <algorithm> // std::find
+#include <cstring>   // std::memchr, std::memcmp
+
+#include <morphio/exceptions.h>
+
+namespace {
+const std::size_t _blockSize = 512;
+
+// Offsets and lengths of the header fields used (POSIX.1-1988 ustar)
+const std::size_t _nameOffset = 0;
+const std::size_t _nameLength = 100;
+const std::size_t _sizeOffset = 124;
+const std::size_t _sizeLength = 12;
+const std::size_t _checksumOffset = 148;
+const std::size_t _checksumLength = 8;
+const std::size_t _typeOffset = 156;
+const std::size_t _magicOffset = 257;
+const std::size_t _prefixOffset = 345;
+const std::size_t _prefixLength = 155;
+
+std::string _field(const char* header, std::size_t offset, std::size_t length)
+{
+    const char* begin = header + offset;
+    const char* end = begin;
+    while (end != begin + length && *end != '\0')
+        ++end;
+    return std::string(begin, end);
+}
+
+// Numbers are octal, space or NUL terminated. GNU tar stores the sizes that
+// do not fit as big endian base-256, flagged by the high bit of the first byte
+bool _number(const char* header, std::size_t offset, std::size_t length, std::size_t& value)
+{
+    const unsigned char* it = reinterpret_cast<const unsigned char*>(header + offset);
+    const unsigned char* end = it + length;
+    value = 0;
+    if (*it & 0x80) {
+        value = *it++ & 0x7f;
+        for (; it != end; ++it) {
+            if (value >> (8 * sizeof(std::size_t) - 8))
+                return false;
+            value = (value << 8) | *it;
+        }
+        return true;
+    }
+
+    while (it != end && *it == ' ')
+        ++it;
+    bool digits = false;
+    for (; it != end && *it >= '0' && *it <= '7'; ++it, digits = true) {
+        if (value >> (8 * sizeof(std::size_t) - 3))
+            return false;
+        value = (value << 3) | static_cast<std::size_t>(*it - '0');
+    }
+    return digits && (it == end || *it == ' ' || *it == '\0');
+}
+
+bool _decimal(const std::string& text, std::size_t& value)
+{
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9' || value > (static_cast<std::size_t>(-1) - 9) / 10)
+            return false;
+        value = value * 10 + static_cast<std::size_t>(c - '0');
+    }
+    return !text.empty();
+}
+
+// The checksum is the sum of the header bytes, the checksum field itself
+// counting as spaces
+bool _validChecksum(const char* header)
+{
+    std::size_t expected = 0;
+    if (!_number(header, _checksumOffset, _checksumLength, expected))
+        return false;
+
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < _blockSize; ++i) {
+        const bool inChecksum = i >= _checksumOffset && i < _checksumOffset + _checksumLength;
+        sum += inChecksum ? static_cast<unsigned char>(' ') : static_cast<unsigned char>(header[i]);
+    }
+    return sum == expected;
+}
+
+bool _isZeroBlock(const char* header)
+{
+    static const char zeros[_blockSize] = {};
+    return std::memcmp(header, zeros, _blockSize) == 0;
+}
+
+// Read the path and size records ("<length> <key>=<value>\n") of a pax
+// extended header
+void _parsePax(const char* begin, const char* end, std::string& path, std::string& size)
+{
+    while (begin < end) {
+        std::size_t length = 0;
+        const char* it = begin;
+        for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+            if (length > (static_cast<std::size_t>(-1) - 9) / 10)
+                return;
+            length = length * 10 + static_cast<std::size_t>(*it - '0');
+        }
+        // The length counts the whole record: its own digits, the space,
+        // at least the trailing newline
+        if (it == end || *it != ' ' || length <= static_cast<std::size_t>(it - begin) + 1 ||
+            length > static_cast<std::size_t>(end - begin))
+            return;
+
+        const char* record = it + 1;
+        const char* recordEnd = begin + length - 1; // without the trailing newline
+        const char* equal = static_cast<const char*>(
+            std::memchr(record, '=', static_cast<std::size_t>(recordEnd - record)));
+        if (equal != nullptr) {
+            const std::string key(record, equal);
+            if (key == "path")
+                path.assign(equal + 1, recordEnd);
+            else if (key == "size")
+                size.assign(equal + 1, recordEnd);
+        }
+        begin += length;
+    }
+}
+
+std::string _normalize(std::string name)
+{
+    while (name.compare(0, 2, "./") == 0)
+        name.erase(0, 2);
+    return name;
+}
+} // namespace
+
+namespace morphio {
+namespace readers {
+namespace tar {
+std::vector<Member> index(const URI& uri, const char* data, std::size_t size)
+{
+    auto error = [&uri](const std::string& reason) {
+        LBTHROW(RawDataError("Reading tar archive '" + uri + "': " + reason));
+    };
+
+    if (size >= 2 && static_cast<unsigned char>(data[0]) == 0x1f &&
+        static_cast<unsigned char>(data[1]) == 0x8b)
+        error("compressed archives can not be read in place, decompress it first");
+
+    std::vector<Member> members;
+    // The name and size overrides set by the GNU long name and pax members
+    // for the member that follows them
+    std::string longName;
+    std::string paxPath;
+    std::string paxSize;
+
+    std::size_t offset = 0;
+    while (offset + _blockSize <= size) {
+        const char* header = data + offset;
+        if (_isZeroBlock(header))
+            return members;
+        if (!_validChecksum(header))
+            error(offset == 0 ? "not a tar archive"
+                              : "invalid header checksum at offset " + std::to_string(offset));
+
+        std::size_t memberSize = 0;
+        const bool validSize = paxSize.empty()
+                                   ? _number(header, _sizeOffset, _sizeLength, memberSize)
+                                   : _decimal(paxSize, memberSize);
+        if (!validSize)
+            error("invalid member size at offset " + std::to_string(offset));
+
+        const std::size_t dataOffset = offset + _blockSize;
+        if (memberSize > size - dataOffset)
+            error("the archive is truncated");
+
+        const char type = header[_typeOffset];
+        const char* memberData = data + dataOffset;
+        if (type == 'L') { // GNU long name of the next member
+            longName.assign(memberData, std::find(memberData, memberData + memberSize, '\0'));
+        } else if (type == 'x') { // pax extended header of the next member
+            _parsePax(memberData, memberData + memberSize, paxPath, paxSize);
+        } else {
+            // Regular and contiguous files, the directories, links, devices
+            // and global pax headers are skipped
+            if (type == '0' || type == '\0' || type == '7') {
+                std::string name = _field(header, _nameOffset, _nameLength);
+                if (!paxPath.empty())
+                    name = paxPath;
+                else if (!longName.empty())
+                    name = longName;
+                else if (std::memcmp(header + _magicOffset, "ustar", 5) == 0) {
+                    const std::string prefix = _field(header, _prefixOffset, _prefixLength);
+                    if (!prefix.empty())
+                        name = prefix + "/" + name;
+                }
+                members.push_back(Member{_normalize(name), dataOffset, memberSize});
+            }
+            longName.clear();
+            paxPath.clear();
+            paxSize.clear();
+        }
+
+        offset = dataOffset + (memberSize + _blockSize - 1) / _blockSize * _blockSize;
+    }
+
+    // Archives without their end-of-archive blocks are still readable as long
+    // as the last member is complete
+    if (offset < size)
+        error("the archive is truncated");
+    return members;
+}
+} // namespace tar
+} // namespace readers
+} // namespace morphio
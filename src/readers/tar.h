@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+namespace readers {
+namespace tar {
+/**
+   A regular file stored in a tar archive: its data is the size bytes
+   starting offset bytes into the archive
+**/
+struct Member
+{
+    std::string name;
+    std::size_t offset;
+    std::size_t size;
+};
+
+/**
+   List the regular files of the uncompressed tar archive held in memory, in
+   archive order, uri is only used in error messages
+
+   The ustar, GNU (long names) and POSIX pax (path and size records) formats
+   are supported. Directories, links and other special members are skipped
+   and a leading "./" is removed from the names. Throw a RawDataError if the
+   data is not a tar archive or is truncated.
+**/
+std::vector<Member> index(const URI& uri, const char* data, std::size_t size);
+} // namespace tar
+} // namespace readers
+} // namespace morphio
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <mutex> // std::recursive_mutex
+
 #include <highfive/H5DataType.hpp>
+#include <highfive/H5File.hpp>
 
 #include <morphio/types.h>
 
@@ -55,3 +58,37 @@ inline AtomicType<morphio::Point>::AtomicType()
     _hid = H5Tcopy(H5T_NATIVE_INT);
 }
 } // namespace HighFive
+
+namespace morphio {
+namespace readers {
+namespace h5 {
+/**
+   The HDF5 library is not thread safe in its default build: every access
+   to an HDF5 file, from opening to closing, must hold this mutex
+
+   It is recursive because objects holding HDF5 handles lock it upon
+   destruction and may be destroyed while it is held
+**/
+std::recursive_mutex& globalHDF5Mutex();
+
+/**
+   File access properties opening an HDF5 file from its image in memory with
+   the core driver, the image is copied by HDF5
+**/
+class FileImageDriver : public HighFive::FileDriver
+{
+public:
+    explicit FileImageDriver(const std::string& image)
+        : FileImageDriver(image.data(), image.size())
+    {}
+
+    FileImageDriver(const char* image, size_t size)
+    {
+        if (H5Pset_fapl_core(getId(), 1 << 20, false) < 0 ||
+            H5Pset_file_image(getId(), const_cast<char*>(image), size) < 0)
+            LBTHROW(RawDataError("Could not set the HDF5 file image"));
+    }
+};
+} // namespace h5
+} // namespace readers
+} // namespace morphio
@@ -18,6 +18,22 @@ vasculature::property::Properties VasculatureHDF5::load()
                                       ? "Could not create vasculature file "
                                       : "Could not open vasculature file " + _uri + ": " + exc.what()));
     }
+    return _load();
+}
+
+vasculature::property::Properties VasculatureHDF5::load(const std::string& image)
+{
+    try {
+        HighFive::SilenceHDF5 silence;
+        _file.reset(new HighFive::File(_uri, HighFive::File::ReadOnly, FileImageDriver(image)));
+    } catch (const HighFive::Exception& exc) {
+        LBTHROW(morphio::RawDataError("Could not open vasculature file " + _uri + ": " + exc.what()));
+    }
+    return _load();
+}
+
+vasculature::property::Properties VasculatureHDF5::_load()
+{
     _readDatasets();
     _readSections();
     _readPoints();
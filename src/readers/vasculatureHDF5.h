@@ -28,7 +28,13 @@ public:
 
     vasculature::property::Properties load();
 
+    /**
+       Parse the image of an HDF5 file held in memory
+    **/
+    vasculature::property::Properties load(const std::string& image);
+
 private:
+    vasculature::property::Properties _load();
     void _readDatasets();
     void _readPoints();
     void _readSections();
@@ -13,7 +13,7 @@ SectionType Section::type() const
 
 depth_iterator Section::depth_begin() const
 {
-    return depth_iterator(*this);
+    return _depthBegin();
 }
 
 depth_iterator Section::depth_end() const
@@ -23,7 +23,7 @@ depth_iterator Section::depth_end() const
 
 breadth_iterator Section::breadth_begin() const
 {
-    return breadth_iterator(*this);
+    return _breadthBegin();
 }
 
 breadth_iterator Section::breadth_end() const
@@ -33,7 +33,7 @@ breadth_iterator Section::breadth_end() const
 
 upstream_iterator Section::upstream_begin() const
 {
-    return upstream_iterator(*this);
+    return upstream_iterator(_properties, _id);
 }
 
 upstream_iterator Section::upstream_end() const
@@ -46,6 +46,17 @@ const range<const Point> Section::points() const
     return get<Property::Point>();
 }
 
+const std::array<range<const float>, 3> Section::pointColumns() const
+{
+    const auto& columns = _properties->pointColumns();
+    std::array<range<const float>, 3> result;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float* data = columns.column(axis).data();
+        result[axis] = range<const float>(data + _range.first, data + _range.second);
+    }
+    return result;
+}
+
 const range<const float> Section::diameters() const
 {
     return get<Property::Diameter>();
@@ -0,0 +1,72 @@
+#include <type_traits> // std::is_trivially_copyable
+
+#include <morphio/section_ref.h>
+
+namespace morphio {
+static_assert(std::is_trivially_copyable<SectionRef>::value, "SectionRef must be trivially copyable");
+static_assert(std::is_trivially_copyable<SectionRefs>::value, "SectionRefs must be trivially copyable");
+static_assert(std::is_trivially_copyable<SectionRefs::iterator>::value,
+    "SectionRefs::iterator must be trivially copyable");
+
+bool SectionRef::isRoot() const
+{
+    return _properties->get<Property::Section>()[_id][1] == -1;
+}
+
+SectionRef SectionRef::parent() const
+{
+    if (isRoot())
+        LBTHROW(MissingParentError(
+            "Cannot call SectionRef::parent() on a root node (section id=" + std::to_string(_id) + ")."));
+
+    return SectionRef(_properties,
+        static_cast<uint32_t>(_properties->get<Property::Section>()[_id][1]));
+}
+
+SectionRefs SectionRef::children() const
+{
+    return SectionRefs(_properties, _properties->children<Property::Section>().children(_id));
+}
+
+SectionType SectionRef::type() const
+{
+    return _properties->get<Property::SectionType>()[_id];
+}
+
+SectionRange SectionRef::_range() const
+{
+    const auto& sections = _properties->get<Property::Section>();
+    const size_t start = static_cast<size_t>(sections[_id][0]);
+    const size_t end = _id == sections.size() - 1
+                           ? _properties->size<Property::Point>()
+                           : static_cast<size_t>(sections[_id + 1][0]);
+    return std::make_pair(start, end);
+}
+
+template <typename TProperty>
+range<const typename TProperty::Type> SectionRef::_get() const
+{
+    const SectionRange range_ = _range();
+    const auto& data = _properties->get<TProperty>(range_);
+    if (data.empty())
+        return range<const typename TProperty::Type>();
+    return range<const typename TProperty::Type>(data.data() + range_.first,
+        data.data() + range_.second);
+}
+
+range<const Point> SectionRef::points() const
+{
+    return _get<Property::Point>();
+}
+
+range<const float> SectionRef::diameters() const
+{
+    return _get<Property::Diameter>();
+}
+
+range<const float> SectionRef::perimeters() const
+{
+    return _get<Property::Perimeter>();
+}
+
+} // namespace morphio
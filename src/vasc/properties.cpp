@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <utility> // std::move
 
 #include <morphio/errorMessages.h>
 #include <morphio/properties.h>
@@ -14,8 +15,8 @@ namespace property {
 
 VascPointLevel::VascPointLevel(std::vector<Point::Type> points,
     std::vector<Diameter::Type> diameters)
-    : _points(points)
-    , _diameters(diameters)
+    : _points(std::move(points))
+    , _diameters(std::move(diameters))
 {
     if (_points.size() != _diameters.size())
         throw SectionBuilderError(
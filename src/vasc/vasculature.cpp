@@ -5,6 +5,7 @@
 #include <morphio/vasc/vasculature.h>
 
 #include "../readers/morphologySWC.h"
+#include "../readers/utilsHDF5.h"
 #include "../readers/vasculatureHDF5.h"
 
 namespace morphio {
@@ -27,6 +28,7 @@ Vasculature::Vasculature(const std::string& source)
 
     property::Properties loader;
     if (extension == ".h5") {
+        std::lock_guard<std::recursive_mutex> lock(readers::h5::globalHDF5Mutex());
         loader = readers::h5::VasculatureHDF5(source).load();
     } else {
         LBTHROW(UnknownFileType("File: " + source + " does not end with the .h5 extension"));
@@ -37,6 +39,22 @@ Vasculature::Vasculature(const std::string& source)
     buildConnectivity(_properties);
 }
 
+Vasculature::Vasculature(const std::string& contents, const std::string& extension)
+{
+    if (extension != "h5" && extension != ".h5")
+        LBTHROW(UnknownFileType("Vasculature: only the h5 format is supported"));
+
+    property::Properties loader;
+    {
+        std::lock_guard<std::recursive_mutex> lock(readers::h5::globalHDF5Mutex());
+        loader = readers::h5::VasculatureHDF5("$STRING$").load(contents);
+    }
+
+    _properties = std::make_shared<property::Properties>(loader);
+
+    buildConnectivity(_properties);
+}
+
 const Section Vasculature::section(const uint32_t& id) const
 {
     return Section(id, _properties);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdlib>  // std::exit, EXIT_FAILURE
+#include <iostream> // std::cerr
+
+/**
+   The C++ tests are plain programs run by ctest: CHECK prints the failing
+   condition and exits with a failure code
+**/
+#define CHECK(condition)                                                            \
+    do {                                                                            \
+        if (!(condition)) {                                                         \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": CHECK(" #condition ")\n"; \
+            std::exit(EXIT_FAILURE);                                                \
+        }                                                                           \
+    } while (false)
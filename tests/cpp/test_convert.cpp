@@ -0,0 +1,94 @@
+#include <cstdlib>    // std::system, EXIT_SUCCESS
+#include <string>     // std::string
+#include <sys/wait.h> // WEXITSTATUS
+#include <unistd.h>   // mkdtemp
+#include <vector>     // std::vector
+
+#include <morphio/container.h>
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+
+#include "check.h"
+
+/**
+   Run morphio-convert on some files of tests/data and read its outputs back
+**/
+
+namespace {
+const std::string _data(MORPHIO_TEST_DATA_DIR);
+const std::vector<std::string> _stems{"simple", "complexe", "Neuron"};
+const std::vector<std::string> _inputs{_data + "/simple.swc",
+    _data + "/complexe.swc",
+    _data + "/h5/v1/Neuron.h5"};
+
+// The exit code of morphio-convert
+int _convert(const std::string& arguments)
+{
+    std::string command = std::string(MORPHIO_CONVERT) + " -q " + arguments;
+    for (const auto& input : _inputs)
+        command += " " + input;
+    const int status = std::system((command + " 2> /dev/null").c_str());
+    return status == -1 ? -1 : WEXITSTATUS(status);
+}
+
+// The morphology as morphio-convert writes it, sanitized
+morphio::Morphology _expected(size_t index)
+{
+    morphio::mut::Morphology morphology(_inputs[index]);
+    morphology.sanitize();
+    return morphio::Morphology(morphology);
+}
+
+void _checkSame(const morphio::Morphology& morphology,
+    const morphio::Morphology& expected,
+    bool samePoints)
+{
+    CHECK(morphology.sections().size() == expected.sections().size());
+    CHECK(morphology.points().size() == expected.points().size());
+    if (samePoints) {
+        CHECK(morphology.points() == expected.points());
+        CHECK(morphology.diameters() == expected.diameters());
+        CHECK(morphology.sectionTypes() == expected.sectionTypes());
+    }
+}
+
+void _checkFiles(const std::string& directory, const std::string& format, bool samePoints)
+{
+    CHECK(_convert("-f " + format + " -o " + directory) == 0);
+    for (size_t i = 0; i < _inputs.size(); ++i)
+        _checkSame(morphio::Morphology(directory + "/" + _stems[i] + "." + format),
+            _expected(i),
+            samePoints);
+}
+} // namespace
+
+int main()
+{
+    char directory[] = "/tmp/morphio-convert-XXXXXX";
+    CHECK(mkdtemp(directory) != nullptr);
+    const std::string output(directory);
+
+    // The SWC writer can move the points shared by sections, only the
+    // sizes are compared
+    _checkFiles(output, "h5", true);
+    _checkFiles(output, "mbin", true);
+    _checkFiles(output, "swc", false);
+
+    const std::string containerPath = output + "/cells.h5";
+    CHECK(_convert("-c -o " + containerPath) == 0);
+    const morphio::Container container(containerPath);
+    CHECK(container.names() == _stems);
+    for (size_t i = 0; i < _inputs.size(); ++i)
+        _checkSame(morphio::Morphology(container, _stems[i]), _expected(i), true);
+
+    // Converting again to the same container fails on every name
+    CHECK(_convert("-c -a -o " + containerPath) == 1);
+    CHECK(morphio::Container(containerPath).names() == _stems);
+
+    // Usage errors
+    CHECK(_convert("-f unknown -o " + output) == 2);
+    CHECK(_convert("-o " + output + "/missing") == 2);
+
+    CHECK(std::system(("rm -rf " + output).c_str()) == 0);
+    return EXIT_SUCCESS;
+}
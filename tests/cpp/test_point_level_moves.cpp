@@ -0,0 +1,78 @@
+#include <cstddef> // size_t
+#include <cstdlib> // std::malloc, std::free, EXIT_SUCCESS
+#include <new>     // std::bad_alloc
+#include <utility> // std::move
+#include <vector>  // std::vector
+
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+
+#include "check.h"
+
+namespace {
+const size_t _nPoints = 1000;
+
+// Every allocation, and those big enough to hold the diameters of a section
+size_t _allocations = 0;
+size_t _bufferAllocations = 0;
+
+morphio::Property::PointLevel _pointLevel()
+{
+    return morphio::Property::PointLevel(std::vector<morphio::Point>(_nPoints, {{1, 2, 3}}),
+        std::vector<float>(_nPoints, 1.f));
+}
+} // namespace
+
+void* operator new(size_t size)
+{
+    ++_allocations;
+    if (size >= _nPoints * sizeof(float))
+        ++_bufferAllocations;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+int main()
+{
+    using morphio::Property::PointLevel;
+    morphio::set_maximum_warnings(0);
+    morphio::mut::Morphology morphology;
+
+    // Copying the point level copies its two buffers, which also checks that
+    // the allocations are counted
+    PointLevel copied = _pointLevel();
+    size_t buffers = _bufferAllocations;
+    morphology.appendRootSection(copied, morphio::SECTION_AXON);
+    CHECK(_bufferAllocations - buffers == 2);
+
+    // Appending from an rvalue moves the buffers in the new section, only
+    // the section itself is allocated
+    PointLevel moved = _pointLevel();
+    buffers = _bufferAllocations;
+    const auto root = morphology.appendRootSection(std::move(moved), morphio::SECTION_AXON);
+    CHECK(_bufferAllocations - buffers == 0);
+    CHECK(root->points().size() == _nPoints);
+
+    buffers = _bufferAllocations;
+    root->appendSection(_pointLevel(), morphio::SECTION_AXON);
+    CHECK(_bufferAllocations - buffers == 2); // only those of the temporary
+
+    // Moving a point level allocates nothing at all
+    PointLevel source = _pointLevel();
+    const size_t allocations = _allocations;
+    PointLevel constructed(std::move(source));
+    PointLevel assigned;
+    assigned = std::move(constructed);
+    CHECK(_allocations - allocations == 0);
+    CHECK(assigned._points.size() == _nPoints);
+    CHECK(assigned._diameters.size() == _nPoints);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#include <cstdint>  // uint32_t
+#include <cstdlib>  // EXIT_SUCCESS
+#include <iterator> // std::distance
+#include <vector>   // std::vector
+
+#include <morphio/morphology.h>
+#include <morphio/section.h>
+#include <morphio/section_ref.h>
+
+#include "check.h"
+
+using morphio::Morphology;
+using morphio::SectionRef;
+using morphio::SectionRefs;
+
+namespace {
+std::vector<uint32_t> _ids(const SectionRefs& refs)
+{
+    std::vector<uint32_t> ids;
+    for (const SectionRef ref : refs)
+        ids.push_back(ref.id());
+    return ids;
+}
+
+template <typename Range>
+std::vector<typename Range::value_type> _values(const Range& range)
+{
+    return std::vector<typename Range::value_type>(range.begin(), range.end());
+}
+
+// The SectionRef of every section must match its Section
+void _checkMorphology(const Morphology& morphology)
+{
+    const SectionRefs refs = morphology.sectionRefs();
+    CHECK(refs.size() == morphology.sections().size());
+
+    uint32_t expectedId = 0;
+    for (const SectionRef ref : refs) {
+        const morphio::Section section = morphology.section(expectedId);
+        CHECK(ref.id() == expectedId);
+        CHECK(ref == refs[expectedId]);
+        CHECK(ref.isRoot() == section.isRoot());
+        if (!ref.isRoot())
+            CHECK(ref.parent().id() == section.parent().id());
+        CHECK(ref.type() == section.type());
+        CHECK(_values(ref.points()) == _values(section.points()));
+        CHECK(_values(ref.diameters()) == _values(section.diameters()));
+        CHECK(_values(ref.perimeters()) == _values(section.perimeters()));
+
+        std::vector<uint32_t> childIds;
+        for (const morphio::Section& child : section.children())
+            childIds.push_back(child.id());
+        CHECK(_ids(ref.children()) == childIds);
+        ++expectedId;
+    }
+    CHECK(expectedId == refs.size());
+}
+} // namespace
+
+int main()
+{
+    const Morphology simple(MORPHIO_TEST_DATA_DIR "/simple.swc");
+    _checkMorphology(simple);
+    _checkMorphology(Morphology(MORPHIO_TEST_DATA_DIR "/complexe.swc"));
+
+    const SectionRef root = simple.sectionRefs()[0];
+    CHECK(root.isRoot());
+    CHECK(root.children().size() == 2);
+
+    // Iterators stay valid once the range they come from is destroyed
+    const SectionRefs::iterator child = root.children().begin();
+    CHECK((*child).parent() == root);
+    const SectionRefs::iterator end = root.children().end();
+    CHECK(std::distance(child, end) == 2);
+
+    bool missingParent = false;
+    try {
+        root.parent();
+    } catch (const morphio::MissingParentError&) {
+        missingParent = true;
+    }
+    CHECK(missingParent);
+
+    return EXIT_SUCCESS;
+}
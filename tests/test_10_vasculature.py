@@ -67,3 +67,11 @@ def test_iterators_vasculature():
     for sec in morphology.iter():
         all_sections.remove(sec.id)
     assert_equal(len(all_sections), 0)
+
+
+def test_read_from_bytes():
+    filename = os.path.join(_path, "h5/vasculature1.h5")
+    with open(filename, 'rb') as f:
+        contents = f.read()
+    assert_array_equal(vasculature.Vasculature(contents, 'h5').points,
+                       vasculature.Vasculature(filename).points)
@@ -303,6 +303,25 @@ def test_read_weird_ids():
                                                         [0., 0., 4.],
                                                         [0., 0., 5.]])
 
+def test_read_number_formats():
+    '''Exponents, signs and ids written as floats are parsed'''
+    with tmp_swc_file('''1 1 0 0 0 1.5e+0 -1.0
+                         2 3 +0 -0 2e0 0.5 1.
+                         3 3 0. .0 3.0E+00 5e-1 2
+                         1000000 3 0 0 4.5 0.5 3 # sparse id
+                         5 3 1.25e-3 -12345.678 0x1p2 0.5 1000000
+                         ''') as tmp_file:
+        neuron = Morphology(tmp_file.name)
+
+    assert_array_equal(neuron.soma.diameters, [3.0])
+    assert_array_equal(neuron.root_sections[0].points,
+                       np.array([[0., 0., 2.],
+                                 [0., 0., 3.],
+                                 [0., 0., 4.5],
+                                 [1.25e-3, -12345.678, 4.]], dtype=np.float32))
+    assert_array_equal(neuron.root_sections[0].diameters, [1., 1., 1., 1.])
+
+
 def test_multiple_soma():
     with assert_raises(SomaError) as obj:
         Morphology(os.path.join(_path, 'multiple_soma.swc'))
@@ -445,3 +464,14 @@ def test_root_node_split():
 def test_three_point_soma():
     n = Morphology(os.path.join(_path, 'three_point_soma.swc'))
     assert_equal(n.soma_type, SomaType.SOMA_NEUROMORPHO_THREE_POINT_CYLINDERS)
+
+
+def test_read_from_string():
+    with open(os.path.join(_path, 'simple.swc')) as f:
+        contents = f.read()
+    from_string = Morphology(contents, 'swc')
+    from_file = Morphology(os.path.join(_path, 'simple.swc'))
+    assert_array_equal(from_string.points, from_file.points)
+    assert_array_equal(from_string.soma.points, from_file.soma.points)
+    assert_array_equal(from_string.section_types, from_file.section_types)
+    assert_raises(RawDataError, Morphology, '1 1 0 0 0 1.0 -1\n2 3 a', 'swc')
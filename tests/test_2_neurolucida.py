@@ -511,3 +511,13 @@ def test_markers():
                                      [-268.17,  -130.62,   -24.75],
                                      [-266.79,  -131.77,   -26.13]],
                                     dtype=np.float32))
+
+
+def test_read_from_string():
+    with open(os.path.join(_path, 'simple.asc')) as f:
+        contents = f.read()
+    from_string = Morphology(contents, 'asc')
+    from_file = Morphology(os.path.join(_path, 'simple.asc'))
+    assert_array_equal(from_string.points, from_file.points)
+    assert_array_equal(from_string.soma.points, from_file.soma.points)
+    assert_array_equal(from_string.section_types, from_file.section_types)
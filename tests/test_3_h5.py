@@ -4,7 +4,8 @@ from itertools import chain, repeat
 from numpy.testing import assert_array_equal
 from nose.tools import assert_equal, assert_raises
 
-from morphio import Morphology, MORPHOLOGY_VERSION_H5_1, MORPHOLOGY_VERSION_H5_2, SectionType, RawDataError
+from morphio import (Morphology, MORPHOLOGY_VERSION_H5_1, MORPHOLOGY_VERSION_H5_2, Option,
+                     SectionType, RawDataError)
 
 _path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
 H5_PATH = os.path.join(_path, 'h5')
@@ -48,6 +49,12 @@ def test_wrong_section_type():
     assert_raises(RawDataError, Morphology, os.path.join(H5V1_PATH, 'simple-broken-section-type.h5'))
 
 
+def test_wrong_parent():
+    path = os.path.join(H5V1_PATH, 'simple-broken-parent.h5')
+    assert_raises(RawDataError, Morphology, path)
+    assert_raises(RawDataError, Morphology, path, Option.nrn_order)
+
+
 def test_v2():
     n = Morphology(os.path.join(H5V2_PATH, 'Neuron.h5'))
     assert_equal(n.version, MORPHOLOGY_VERSION_H5_2)
@@ -72,3 +79,40 @@ def test_soma_no_neurite():
                        [6,6,15])
 
     assert_equal(len(n.root_sections), 0)
+
+
+def test_read_from_bytes():
+    filename = os.path.join(H5V1_PATH, 'Neuron.h5')
+    with open(filename, 'rb') as f:
+        contents = f.read()
+    from_bytes = Morphology(contents, 'h5')
+    from_file = Morphology(filename)
+    assert_array_equal(from_bytes.points, from_file.points)
+    assert_array_equal(from_bytes.perimeters, from_file.perimeters)
+    assert_array_equal(from_bytes.section_types, from_file.section_types)
+    assert_raises(RawDataError, Morphology, b'not an hdf5 file', 'h5')
+
+
+def test_lazy_load():
+    for filename in [os.path.join(H5V1_PATH, 'Neuron.h5'),
+                     os.path.join(H5V1_PATH, 'soma_no_neurites.h5'),
+                     os.path.join(H5V2_PATH, 'Neuron.h5')]:
+        eager = Morphology(filename)
+        for option in (Option.lazy_load, Option.lazy_load_sections):
+            lazy = Morphology(filename, options=option)
+            assert_array_equal(lazy.soma.points, eager.soma.points)
+            assert_array_equal(lazy.section_types, eager.section_types)
+            for lazy_section, eager_section in zip(reversed(lazy.sections),
+                                                   reversed(eager.sections)):
+                assert_array_equal(lazy_section.points, eager_section.points)
+                assert_array_equal(lazy_section.diameters, eager_section.diameters)
+            assert_array_equal(lazy.points, eager.points)
+            assert_array_equal(lazy.diameters, eager.diameters)
+            assert_array_equal(lazy.perimeters, eager.perimeters)
+
+    # Modifiers are still applied
+    assert_array_equal(
+        Morphology(os.path.join(H5V1_PATH, 'Neuron.h5'),
+                   options=Option.lazy_load | Option.two_points_sections).points,
+        Morphology(os.path.join(H5V1_PATH, 'Neuron.h5'),
+                   options=Option.two_points_sections).points)
@@ -1,11 +1,19 @@
+import gzip
 import os
+import shutil
+import tarfile
+import tempfile
+import threading
 import numpy as np
 from collections import OrderedDict
 from itertools import combinations
 from numpy.testing import assert_array_equal, assert_array_almost_equal
 from nose.tools import assert_equal, assert_not_equal, assert_raises, ok_
 
-from morphio import Morphology, upstream, IterType, RawDataError
+from morphio import (Archive, Collection, Container, Morphology, Prefetcher, load_async,
+                     upstream, IterType, MorphioError, RawDataError, Option, SectionType,
+                     set_cache_capacity, cache_statistics, invalidate_cache, clear_cache)
+from morphio.mut import ContainerWriter
 
 _path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
 
@@ -31,6 +39,13 @@ def test_distance():
         ok_(cell.soma.max_distance == 0.)
 
 
+def test_point_columns():
+    for _, cell in CELLS.items():
+        assert_array_equal(cell.point_columns, cell.points.T)
+        for section in cell.iter():
+            assert_array_equal(section.point_columns, section.points.T)
+
+
 def test_iter():
     neuron = Morphology(os.path.join(_path, "iterators.asc"))
     root = neuron.root_sections[0]
@@ -56,6 +71,28 @@ def test_iter():
                              [0., 5., 0.]]])
 
 
+def test_iter_orders():
+    def depth_first(section):
+        yield section.id
+        for child in section.children:
+            for id_ in depth_first(child):
+                yield id_
+
+    neuron = Morphology(os.path.join(_path, "iterators.asc"))
+    for section in neuron.iter():
+        assert_array_equal([s.id for s in section.iter(IterType.depth_first)],
+                           list(depth_first(section)))
+        ids = [s.id for s in section.iter(upstream)]
+        assert_equal(ids[0], section.id)
+        if section.is_root:
+            assert_equal(len(ids), 1)
+        else:
+            assert_array_equal(ids[1:], [s.id for s in section.parent.iter(upstream)])
+
+    assert_array_equal([section.id for section in neuron.root_sections[1].iter(IterType.breadth_first)],
+                       [7, 8, 9])
+
+
 def test_mitochondria():
     morpho = Morphology(os.path.join(_path, "h5/v1/mitochondria.h5"))
     mito = morpho.mitochondria
@@ -92,6 +129,354 @@ def test_mitochondria():
     assert_equal(len(mito_root[1].children), 0)
 
 
+def test_section_types():
+    for filename in ['simple.asc', 'simple.swc', 'h5/v1/simple.h5', 'h5/v1/Neuron.h5',
+                     'h5/v2/Neuron.h5']:
+        path = os.path.join(_path, filename)
+        full = Morphology(path)
+        for types in ({SectionType.axon},
+                      {SectionType.basal_dendrite, SectionType.apical_dendrite}):
+            selected = Morphology(path, section_types=types)
+            expected = [root for root in full.root_sections if root.type in types]
+            assert_equal(len(selected.root_sections), len(expected))
+            ok_(len(selected.sections) < len(full.sections))
+            assert_array_equal(selected.soma.points, full.soma.points)
+            for root, expected_root in zip(selected.root_sections, expected):
+                for section, expected_section in zip(root.iter(), expected_root.iter()):
+                    assert_equal(section.type, expected_section.type)
+                    assert_array_equal(section.points, expected_section.points)
+                    assert_array_equal(section.diameters, expected_section.diameters)
+
+        # An empty set loads everything
+        assert_array_equal(Morphology(path, section_types=set()).points, full.points)
+
+    # The neurites of the selected types are read lazily as well
+    path = os.path.join(_path, 'h5/v1/Neuron.h5')
+    assert_array_equal(
+        Morphology(path, options=Option.lazy_load_sections,
+                   section_types={SectionType.axon}).points,
+        Morphology(path, section_types={SectionType.axon}).points)
+
+
+def test_gzip():
+    tmp_folder = tempfile.mkdtemp()
+    try:
+        for filename in ['simple.asc', 'simple.swc']:
+            path = os.path.join(_path, filename)
+            compressed = os.path.join(tmp_folder, filename + '.gz')
+            with open(path, 'rb') as source, gzip.open(compressed, 'wb') as dest:
+                shutil.copyfileobj(source, dest)
+
+            expected = Morphology(path)
+            morph = Morphology(compressed)
+            assert_array_equal(morph.points, expected.points)
+            assert_array_equal(morph.diameters, expected.diameters)
+            assert_array_equal(morph.soma.points, expected.soma.points)
+            assert_equal(len(morph.sections), len(expected.sections))
+
+        ok_(os.path.join(tmp_folder, 'simple.swc.gz') in
+            Collection.from_directory(tmp_folder).uris)
+
+        # Only SWC and ASC can be compressed
+        with open(os.path.join(_path, 'h5/v1/simple.h5'), 'rb') as source, \
+                gzip.open(os.path.join(tmp_folder, 'simple.h5.gz'), 'wb') as dest:
+            shutil.copyfileobj(source, dest)
+        assert_raises(MorphioError, Morphology, os.path.join(tmp_folder, 'simple.h5.gz'))
+
+        with open(os.path.join(tmp_folder, 'truncated.swc.gz'), 'wb') as dest:
+            with open(os.path.join(tmp_folder, 'simple.swc.gz'), 'rb') as source:
+                dest.write(source.read()[:-10])
+        assert_raises(RawDataError, Morphology, os.path.join(tmp_folder, 'truncated.swc.gz'))
+    finally:
+        shutil.rmtree(tmp_folder)
+
+
+def test_archive():
+    tmp_folder = tempfile.mkdtemp()
+    try:
+        filenames = ['simple.asc', 'simple.swc', 'h5/v1/simple.h5', 'h5/v1/Neuron.h5']
+        archive_path = os.path.join(tmp_folder, 'cells.tar')
+        with tarfile.open(archive_path, 'w', format=tarfile.PAX_FORMAT) as tar:
+            tar.add(os.path.join(_path, 'h5'), arcname='./h5', recursive=False)
+            for filename in filenames:
+                tar.add(os.path.join(_path, filename), arcname='./' + filename)
+            # Names longer than the 100 characters of the ustar header
+            tar.add(os.path.join(_path, 'simple.swc'), arcname='a' * 120 + '/simple.swc')
+
+        archive = Archive(archive_path)
+        assert_equal(archive.names, filenames + ['a' * 120 + '/simple.swc'])
+        assert_equal(len(archive), 5)
+        ok_('simple.asc' in archive)
+        ok_('h5' not in archive)
+
+        for filename in filenames:
+            expected = Morphology(os.path.join(_path, filename), options=Option.nrn_order)
+            morph = archive.morphology(filename, options=Option.nrn_order)
+            assert_array_equal(morph.points, expected.points)
+            assert_array_equal(morph.diameters, expected.diameters)
+            assert_array_equal(morph.section_types, expected.section_types)
+
+        assert_array_equal(
+            archive.morphology('h5/v1/Neuron.h5', section_types={SectionType.axon}).points,
+            Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'), section_types={SectionType.axon}).points)
+        assert_array_equal(archive.morphology('a' * 120 + '/simple.swc').points,
+                           CELLS['swc'].points)
+        assert_raises(RawDataError, archive.morphology, 'missing.swc')
+
+        with open(os.path.join(tmp_folder, 'truncated.tar'), 'wb') as dest:
+            with open(archive_path, 'rb') as source:
+                dest.write(source.read()[:3000])
+        assert_raises(RawDataError, Archive, os.path.join(tmp_folder, 'truncated.tar'))
+        assert_raises(RawDataError, Archive, os.path.join(_path, 'simple.swc'))
+
+        # Pax records whose length is shorter than its own prefix or
+        # overflows are ignored
+        with tarfile.open(archive_path, 'w', format=tarfile.PAX_FORMAT) as tar:
+            tar.add(os.path.join(_path, 'simple.swc'), arcname='simple.swc')
+            info = tar.gettarinfo(os.path.join(_path, 'simple.swc'), arcname='other.swc')
+            info.pax_headers = {'comment': 'abcdefghijklmnop'}
+            with open(os.path.join(_path, 'simple.swc'), 'rb') as source:
+                tar.addfile(info, source)
+        with open(archive_path, 'rb') as source:
+            contents = source.read()
+        record = b'28 comment=abcdefghijklmnop\n'
+        ok_(record in contents)
+        for broken in [b'1 ', b'99999999999999999999 ']:
+            with open(archive_path, 'wb') as dest:
+                dest.write(contents.replace(record, broken + b'x' * (len(record) - len(broken))))
+            archive = Archive(archive_path)
+            assert_equal(archive.names, ['simple.swc', 'other.swc'])
+            assert_array_equal(archive.morphology('other.swc').points, CELLS['swc'].points)
+    finally:
+        shutil.rmtree(tmp_folder)
+
+
+def test_container():
+    tmp_folder = tempfile.mkdtemp()
+    try:
+        filenames = ['simple.asc', 'h5/v1/mitochondria.h5', 'simple.swc', 'h5/v1/Neuron.h5']
+        container_path = os.path.join(tmp_folder, 'cells.h5')
+        with ContainerWriter(container_path) as writer:
+            for filename in filenames:
+                writer.add(filename, Morphology(os.path.join(_path, filename)))
+            assert_raises(MorphioError, writer.add, 'simple.swc', CELLS['swc'])
+
+        container = Container(container_path)
+        assert_equal(container.names, filenames)
+        assert_equal(len(container), 4)
+        ok_('simple.swc' in container)
+        ok_('missing.swc' not in container)
+
+        for filename in filenames:
+            expected = Morphology(os.path.join(_path, filename), options=Option.nrn_order)
+            morph = Morphology(container, filename, options=Option.nrn_order)
+            assert_array_equal(morph.points, expected.points)
+            assert_array_equal(morph.diameters, expected.diameters)
+            assert_array_equal(morph.section_types, expected.section_types)
+            assert_array_equal(morph.soma.points, expected.soma.points)
+
+        mito = Morphology(container, 'h5/v1/mitochondria.h5').mitochondria
+        expected = Morphology(os.path.join(_path, 'h5/v1/mitochondria.h5')).mitochondria
+        assert_equal(len(mito.root_sections), len(expected.root_sections))
+        for root, expected_root in zip(mito.root_sections, expected.root_sections):
+            for section, expected_section in zip(root.iter(), expected_root.iter()):
+                assert_array_equal(section.diameters, expected_section.diameters)
+                assert_array_equal(section.neurite_section_ids,
+                                   expected_section.neurite_section_ids)
+        assert_equal(len(Morphology(container, 'simple.swc').mitochondria.root_sections), 0)
+
+        assert_array_equal(
+            Morphology(container, 'h5/v1/Neuron.h5', section_types={SectionType.axon}).points,
+            Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'), section_types={SectionType.axon}).points)
+        assert_raises(RawDataError, Morphology, container, 'missing.swc')
+        assert_raises(RawDataError, Container, os.path.join(_path, 'h5/v1/simple.h5'))
+
+        # The index grows with each add(), before the writer is closed
+        partial_path = os.path.join(tmp_folder, 'partial.h5')
+        with ContainerWriter(partial_path) as writer:
+            assert_equal(Container(partial_path).names, [])
+            writer.add('simple.swc', CELLS['swc'])
+            partial = Container(partial_path)
+            assert_equal(partial.names, ['simple.swc'])
+            assert_array_equal(Morphology(partial, 'simple.swc').points, CELLS['swc'].points)
+            del partial
+    finally:
+        shutil.rmtree(tmp_folder)
+
+
+def test_container_append():
+    tmp_folder = tempfile.mkdtemp()
+    try:
+        container_path = os.path.join(tmp_folder, 'cells.h5')
+        with ContainerWriter(container_path, append=True) as writer:
+            writer.add('simple.swc', CELLS['swc'])
+
+        # The producer threads only share the writer
+        filenames = ['simple.asc', 'h5/v1/mitochondria.h5', 'h5/v1/Neuron.h5', 'complexe.swc']
+        with ContainerWriter(container_path, append=True) as writer:
+            assert_raises(MorphioError, writer.add, 'simple.swc', CELLS['swc'])
+            threads = [threading.Thread(target=writer.add,
+                                        args=(filename,
+                                              Morphology(os.path.join(_path, filename))))
+                       for filename in filenames]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+
+        container = Container(container_path)
+        assert_equal(sorted(container.names), sorted(['simple.swc'] + filenames))
+        assert_equal(container.names[0], 'simple.swc')
+        for filename in ['simple.swc'] + filenames:
+            expected = Morphology(os.path.join(_path, filename))
+            morph = Morphology(container, filename)
+            assert_array_equal(morph.points, expected.points)
+            assert_array_equal(morph.diameters, expected.diameters)
+            assert_array_equal(morph.section_types, expected.section_types)
+        assert_equal(len(Morphology(container, 'h5/v1/mitochondria.h5').mitochondria.root_sections),
+                     2)
+
+        not_container = os.path.join(tmp_folder, 'simple.h5')
+        shutil.copy(os.path.join(_path, 'h5/v1/simple.h5'), not_container)
+        assert_raises(MorphioError, ContainerWriter, not_container, append=True)
+    finally:
+        shutil.rmtree(tmp_folder)
+
+
 def test_section___str__():
     assert_equal(str(CELLS['asc'].root_sections[0]),
                  'Section(id=0, points=[(0 0 0),..., (0 5 0)])')
+
+
+def test_collection():
+    filenames = [os.path.join(_path, "simple.asc"),
+                 os.path.join(_path, "does_not_exist.swc"),
+                 os.path.join(_path, "simple.swc"),
+                 os.path.join(_path, "h5/v1/simple.h5")]
+    collection = Collection(filenames, n_threads=2, max_in_flight=1)
+    assert_equal(len(collection), 4)
+    assert_equal(collection.n_threads, 2)
+
+    results = collection.load()
+    assert_equal([result.index for result in results], [0, 1, 2, 3])
+    assert_equal([result.uri for result in results], filenames)
+    ok_(results[1].morphology is None)
+    ok_('does not exist' in results[1].error)
+    for i in (0, 2, 3):
+        assert_equal(results[i].error, '')
+        assert_array_equal(results[i].morphology.points, CELLS['asc'].points)
+
+    indices = []
+    collection.load(lambda result: indices.append(result.index), ordered=True)
+    assert_equal(indices, [0, 1, 2, 3])
+
+    indices = []
+    collection.load(lambda result: indices.append(result.index))
+    assert_equal(sorted(indices), [0, 1, 2, 3])
+
+
+def test_collection_batches():
+    # More files than a batch, with errors in the middle of the batches
+    filenames = [os.path.join(_path, name) for name in sorted(os.listdir(_path))
+                 if name.endswith('.swc') or name.endswith('.asc')] * 3
+    filenames.insert(20, os.path.join(_path, "does_not_exist.asc"))
+    for result in Collection(filenames, options=Option.nrn_order, n_threads=3).load():
+        try:
+            expected = Morphology(result.uri, options=Option.nrn_order)
+        except MorphioError as e:
+            ok_(result.morphology is None)
+            assert_equal(result.error, str(e))
+            continue
+        assert_equal(result.error, '')
+        assert_array_equal(result.morphology.points, expected.points)
+        assert_array_equal(result.morphology.section_types, expected.section_types)
+
+
+def test_prefetcher():
+    filenames = [os.path.join(_path, "simple.asc"),
+                 os.path.join(_path, "does_not_exist.swc"),
+                 os.path.join(_path, "simple.swc"),
+                 os.path.join(_path, "h5/v1/simple.h5")] * 3
+    prefetcher = Prefetcher(filenames, n_threads=2, depth=3)
+    assert_equal((len(prefetcher), prefetcher.depth), (12, 3))
+    results = list(prefetcher)
+    assert_equal([result.index for result in results], list(range(12)))
+    for result in results:
+        if result.index % 4 == 1:
+            ok_(result.morphology is None)
+            ok_('does not exist' in result.error)
+        else:
+            assert_array_equal(result.morphology.points, CELLS['asc'].points)
+
+    prefetcher = Prefetcher(filenames, depth=2)
+    assert_equal(next(prefetcher).index, 0)
+    prefetcher.cancel()
+    assert_equal(list(prefetcher), [])
+
+
+def test_load_async():
+    future = load_async(os.path.join(_path, "simple.swc"), options=Option.nrn_order)
+    assert_array_equal(future.result().points, CELLS['swc'].points)
+    ok_(future.done())
+    assert_raises(RawDataError, load_async(os.path.join(_path, "does_not_exist.swc")).result)
+
+
+def test_collection_from_directory():
+    collection = Collection.from_directory(_path)
+    assert_equal(collection.uris, sorted(collection.uris))
+    ok_(os.path.join(_path, 'simple.asc') in collection.uris)
+    ok_(all(result.morphology is not None or result.error
+            for result in collection.load()))
+    assert_raises(RawDataError, Collection.from_directory,
+                  os.path.join(_path, 'does_not_exist'))
+
+
+def test_cache():
+    filename = os.path.join(_path, "simple.swc")
+    set_cache_capacity(100 * 1024 * 1024)
+    try:
+        clear_cache()
+        first = Morphology(filename)
+        second = Morphology(os.path.join(_path, "..", "data", "simple.swc"))
+        assert_array_equal(first.points, second.points)
+        stats = cache_statistics()
+        assert_equal((stats.hits, stats.misses, stats.entries), (1, 1, 1))
+        ok_(stats.bytes > 0)
+
+        # Options are part of the key
+        Morphology(filename, options=Option.two_points_sections)
+        assert_equal(cache_statistics().entries, 2)
+
+        invalidate_cache(filename)
+        assert_equal(cache_statistics().entries, 0)
+        Morphology(filename)
+        assert_equal(cache_statistics().misses, 3)
+
+        # A single entry can use the whole budget, but not more
+        bytes = cache_statistics().bytes
+        clear_cache()
+        set_cache_capacity(bytes)
+        Morphology(filename)
+        assert_equal(cache_statistics().entries, 1)
+        clear_cache()
+        set_cache_capacity(bytes - 1)
+        Morphology(filename)
+        assert_equal(cache_statistics().entries, 0)
+
+        # The entries of the other shards are evicted to make room
+        set_cache_capacity(2 * bytes)
+        for name in ("simple.swc", "complexe.swc", "three_point_soma.swc", "simple2.asc"):
+            Morphology(os.path.join(_path, name))
+            ok_(cache_statistics().bytes <= 2 * bytes)
+
+        # Lazily loaded points are charged when the entry is inserted
+        clear_cache()
+        set_cache_capacity(100 * 1024 * 1024)
+        lazy = Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'), options=Option.lazy_load)
+        bytes = cache_statistics().bytes
+        points = lazy.points
+        ok_(bytes >= points.shape[0] * 4 * 4)
+        assert_equal(cache_statistics().bytes, bytes)
+    finally:
+        set_cache_capacity(0)
+        clear_cache()
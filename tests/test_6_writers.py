@@ -1,11 +1,13 @@
 import os
+import struct
 import numpy as np
 from numpy.testing import assert_array_equal, assert_equal, assert_raises
 from nose.tools import ok_
 
-from morphio.mut import Morphology
-from morphio import (SectionBuilderError, set_maximum_warnings, SectionType, PointLevel,
-                     MitochondriaPointLevel, Morphology as ImmutMorphology, ostream_redirect)
+from morphio.mut import H5Options, Morphology
+from morphio import (MorphioError, RawDataError, SectionBuilderError, set_maximum_warnings, SectionType,
+                     PointLevel, MitochondriaPointLevel, Morphology as ImmutMorphology,
+                     ostream_redirect, Option)
 
 from utils import captured_output, setup_tempdir
 
@@ -144,6 +146,92 @@ def test_write_perimeter():
                            [5., 6., 6., 7., 6., 8.])
 
 
+def test_write_binary():
+    neuron = ImmutMorphology(os.path.join(_path, 'h5/v1/Neuron.h5'))
+
+    with setup_tempdir('test_write_binary') as tmp_folder:
+        neuron.as_mutable().write(os.path.join(tmp_folder, 'test_write.h5'))
+        neuron.as_mutable().write(os.path.join(tmp_folder, 'test_write.mbin'))
+        expected = ImmutMorphology(os.path.join(tmp_folder, 'test_write.h5'))
+        read = ImmutMorphology(os.path.join(tmp_folder, 'test_write.mbin'))
+
+        assert_array_equal(read.points, expected.points)
+        assert_array_equal(read.diameters, expected.diameters)
+        assert_array_equal(read.section_types, expected.section_types)
+        assert_array_equal(read.soma.points, expected.soma.points)
+        assert_equal(read.soma_type, expected.soma_type)
+        assert_equal(read.version, neuron.version)
+        assert_equal([len(section.children) for section in read.iter()],
+                     [len(section.children) for section in expected.iter()])
+
+
+def test_write_binary_corrupted():
+    neuron = Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'))
+
+    with setup_tempdir('test_write_binary_corrupted') as tmp_folder:
+        path = os.path.join(tmp_folder, 'valid.mbin')
+        neuron.write(path)
+        with open(path, 'rb') as f:
+            data = bytearray(f.read())
+
+        # The (offset, count) entries of the arrays follow the 32 bytes of
+        # the fixed header fields
+        def entry(array):
+            return 32 + 16 * array
+
+        def corrupted(name, patch):
+            corrupted_data = bytearray(data)
+            patch(corrupted_data)
+            corrupted_path = os.path.join(tmp_folder, name)
+            with open(corrupted_path, 'wb') as f:
+                f.write(corrupted_data)
+            return corrupted_path
+
+        def drop_soma_diameter(buf):
+            count, = struct.unpack_from('<Q', buf, entry(6) + 8)
+            struct.pack_into('<Q', buf, entry(6) + 8, count - 1)
+
+        def swap_section_offsets(buf):
+            offset, = struct.unpack_from('<Q', buf, entry(3))
+            first, second = struct.unpack_from('<ii', buf, offset + 8), struct.unpack_from('<ii', buf, offset + 16)
+            struct.pack_into('<ii', buf, offset + 8, second[0], first[1])
+            struct.pack_into('<ii', buf, offset + 16, first[0], second[1])
+
+        assert_raises(RawDataError, ImmutMorphology,
+                      corrupted('soma.mbin', drop_soma_diameter))
+        assert_raises(RawDataError, ImmutMorphology,
+                      corrupted('offsets.mbin', swap_section_offsets))
+
+def test_write_compressed():
+    neuron = Morphology(os.path.join(_path, 'h5/v1/Neuron.h5'))
+
+    with setup_tempdir('test_write_compressed') as tmp_folder:
+        plain_path = os.path.join(tmp_folder, 'plain.h5')
+        neuron.write(plain_path)
+
+        options = H5Options()
+        options.chunk_size = 100
+        options.deflate_level = 1
+        options.shuffle = True
+        compressed_path = os.path.join(tmp_folder, 'compressed.h5')
+        neuron.write(compressed_path, options)
+        ok_(os.path.getsize(compressed_path) < os.path.getsize(plain_path))
+
+        expected = ImmutMorphology(plain_path)
+        for read in (ImmutMorphology(compressed_path),
+                     ImmutMorphology(compressed_path, options=Option.lazy_load)):
+            assert_array_equal(read.points, expected.points)
+            assert_array_equal(read.diameters, expected.diameters)
+            assert_array_equal(read.section_types, expected.section_types)
+            assert_array_equal(read.soma.points, expected.soma.points)
+
+        options.deflate_level = 10
+        assert_raises(MorphioError, neuron.write, compressed_path, options)
+        options.deflate_level = 1
+        options.chunk_size = 0
+        assert_raises(MorphioError, neuron.write, compressed_path, options)
+
+
 def test_write_no_soma():
     morpho = Morphology()
     dendrite = morpho.append_root_section(
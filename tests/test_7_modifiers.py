@@ -75,3 +75,27 @@ def test_no_duplicate():
             m = Morphology(SIMPLE, options=Option.no_duplicates|Option.nrn_order)
     assert_array_equal([section.points.tolist() for section in m.iter()],
                        neurite2 + neurite1)
+
+
+def test_h5_modifiers():
+    # H5 modifiers are applied on the loaded arrays, they must give the same
+    # result as the mutable morphology ones
+    for filename in ['h5/v1/Neuron.h5', 'h5/v1/simple.h5', 'h5/v2/Neuron.h5']:
+        path = os.path.join(_path, filename)
+        for options in [Option.two_points_sections, Option.soma_sphere,
+                        Option.no_duplicates, Option.nrn_order,
+                        Option.no_duplicates | Option.nrn_order | Option.soma_sphere]:
+            with captured_output():
+                with ostream_redirect(stdout=True, stderr=True):
+                    m = Morphology(path, options=options)
+                    expected = Morphology(MutableMorphology(Morphology(path), options=options))
+            assert_array_equal(m.soma.points, expected.soma.points)
+            assert_array_equal(m.soma.diameters, expected.soma.diameters)
+            assert_array_equal(m.section_types, expected.section_types)
+            assert_array_equal(m.points, expected.points)
+            assert_array_equal(m.diameters, expected.diameters)
+            assert_array_equal(m.perimeters, expected.perimeters)
+            assert_equal([section.parent.id if not section.is_root else -1
+                          for section in m.iter()],
+                         [section.parent.id if not section.is_root else -1
+                          for section in expected.iter()])
@@ -0,0 +1,425 @@
+/**
+   morphio-convert: convert morphology files between formats on a pool of
+   threads
+
+   Usage: morphio-convert [options] -o OUTPUT INPUT...
+
+   Each INPUT is a morphology file or a directory whose morphology files are
+   all converted (not recursively). See --help for the options.
+**/
+#include <algorithm>          // std::transform
+#include <atomic>             // std::atomic
+#include <cctype>             // std::tolower
+#include <chrono>             // std::chrono
+#include <condition_variable> // std::condition_variable
+#include <cstdlib>            // std::strtoul
+#include <iomanip>            // std::setprecision
+#include <iostream>           // std::cerr
+#include <map>                // std::map
+#include <memory>             // std::unique_ptr
+#include <mutex>              // std::mutex
+#include <sstream>            // std::ostringstream
+#include <stdexcept>          // std::runtime_error
+#include <string>             // std::string
+#include <sys/stat.h>         // stat
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+
+#include <morphio/collection.h>
+#include <morphio/errorMessages.h>
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/mut/writers.h>
+#include <morphio/version.h>
+
+namespace {
+const char* const _usage =
+    "Usage: morphio-convert [options] -o OUTPUT INPUT...\n"
+    "\n"
+    "Convert morphology files (SWC, ASC, H5, MBIN, gzip compressed SWC and ASC)\n"
+    "on a pool of threads. Each INPUT is a file or a directory whose morphology\n"
+    "files are all converted (not recursively).\n"
+    "\n"
+    "Options:\n"
+    "  -o, --output PATH     output directory, or container file with --container\n"
+    "  -f, --format FORMAT   output format: swc, asc, h5 or mbin (default: h5)\n"
+    "  -c, --container       write all the morphologies in one HDF5 container\n"
+    "  -a, --append          append to the container instead of replacing it\n"
+    "  -j, --threads N       number of threads (default: one per hardware thread)\n"
+    "  --chunk-size N        rows of the chunks of compressed H5 datasets\n"
+    "  --deflate LEVEL       deflate level of the H5 datasets, 0 to 9 (default: 0)\n"
+    "  --shuffle             shuffle the bytes of the H5 datasets before deflate\n"
+    "  -w, --warnings        print the warnings of the readers\n"
+    "  -q, --quiet           no progress output\n"
+    "  -h, --help            print this help\n"
+    "  -v, --version         print the version of MorphIO\n";
+
+enum class Format { SWC, ASC, H5, MBIN };
+
+struct Arguments
+{
+    std::vector<std::string> inputs;
+    std::string output;
+    Format format = Format::H5;
+    bool container = false;
+    bool append = false;
+    unsigned int nThreads = 0;
+    morphio::mut::writer::H5Options h5Options;
+    bool warnings = false;
+    bool quiet = false;
+};
+
+struct UsageError
+{
+    std::string message;
+};
+
+std::string _lower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(),
+        [](char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+unsigned long _number(const std::string& option, const std::string& value)
+{
+    char* end = nullptr;
+    const unsigned long number = std::strtoul(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0')
+        throw UsageError{"invalid number for " + option + ": " + value};
+    return number;
+}
+
+Arguments _parse(int argc, char* argv[])
+{
+    Arguments args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const auto value = [&]() {
+            if (i + 1 == argc)
+                throw UsageError{"missing value for " + arg};
+            return std::string(argv[++i]);
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            std::cout << _usage;
+            std::exit(0);
+        } else if (arg == "-v" || arg == "--version") {
+            std::cout << "morphio-convert " << morphio::getVersionString() << '\n';
+            std::exit(0);
+        } else if (arg == "-o" || arg == "--output") {
+            args.output = value();
+        } else if (arg == "-f" || arg == "--format") {
+            const std::string format = _lower(value());
+            if (format == "swc")
+                args.format = Format::SWC;
+            else if (format == "asc")
+                args.format = Format::ASC;
+            else if (format == "h5")
+                args.format = Format::H5;
+            else if (format == "mbin")
+                args.format = Format::MBIN;
+            else
+                throw UsageError{"unknown output format: " + format};
+        } else if (arg == "-c" || arg == "--container") {
+            args.container = true;
+        } else if (arg == "-a" || arg == "--append") {
+            args.append = true;
+        } else if (arg == "-j" || arg == "--threads") {
+            args.nThreads = static_cast<unsigned int>(_number(arg, value()));
+        } else if (arg == "--chunk-size") {
+            args.h5Options.chunkSize = _number(arg, value());
+        } else if (arg == "--deflate") {
+            args.h5Options.deflateLevel = static_cast<unsigned int>(_number(arg, value()));
+        } else if (arg == "--shuffle") {
+            args.h5Options.shuffle = true;
+        } else if (arg == "-w" || arg == "--warnings") {
+            args.warnings = true;
+        } else if (arg == "-q" || arg == "--quiet") {
+            args.quiet = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            throw UsageError{"unknown option: " + arg};
+        } else {
+            args.inputs.push_back(arg);
+        }
+    }
+
+    if (args.output.empty())
+        throw UsageError{"no output given"};
+    if (args.inputs.empty())
+        throw UsageError{"no input given"};
+    if (args.append && !args.container)
+        throw UsageError{"--append needs --container"};
+    return args;
+}
+
+bool _isDirectory(const std::string& path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+size_t _fileSize(const std::string& path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+}
+
+std::vector<std::string> _inputFiles(const std::vector<std::string>& inputs)
+{
+    std::vector<std::string> files;
+    for (const auto& input : inputs) {
+        if (_isDirectory(input)) {
+            const auto uris = morphio::Collection::fromDirectory(input).uris();
+            files.insert(files.end(), uris.begin(), uris.end());
+        } else {
+            files.push_back(input);
+        }
+    }
+    return files;
+}
+
+/**
+   The file name without directory nor extension, a .gz being skipped
+**/
+std::string _stem(const std::string& path)
+{
+    const size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (_lower(name).size() > 3 && _lower(name).compare(name.size() - 3, 3, ".gz") == 0)
+        name.resize(name.size() - 3);
+    const size_t dot = name.find_last_of('.');
+    return dot == std::string::npos || dot == 0 ? name : name.substr(0, dot);
+}
+
+std::string _extension(Format format)
+{
+    switch (format) {
+    case Format::SWC:
+        return ".swc";
+    case Format::ASC:
+        return ".asc";
+    case Format::MBIN:
+        return ".mbin";
+    case Format::H5:
+    default:
+        return ".h5";
+    }
+}
+
+/**
+   The checks and the cleaning of mut::Morphology::write, made in place
+   rather than on a copy
+**/
+void _prepare(morphio::mut::Morphology& morphology)
+{
+    morphology.sanitize();
+    for (const auto& root : morphology.rootSections())
+        if (root->points().size() < 2)
+            throw morphio::SectionBuilderError("Root sections must have at least 2 points");
+}
+
+/**
+   Convert the files claimed one by one by the threads of the pool
+**/
+class Converter
+{
+public:
+    Converter(const Arguments& args, const std::vector<std::string>& files)
+        : _args(args)
+        , _files(files)
+    {
+        if (_args.container)
+            _container.reset(new morphio::mut::writer::ContainerWriter(
+                _args.output, _args.h5Options, _args.append));
+        _outputs = _outputNames();
+    }
+
+    void run()
+    {
+        const unsigned int nThreads = _args.nThreads > 0
+                                          ? _args.nThreads
+                                          : std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < nThreads; ++i)
+            threads.emplace_back([this]() { _work(); });
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_fileDone.wait_for(lock, std::chrono::milliseconds(200),
+                [this]() { return _done == _files.size(); }))
+                _progress();
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        if (_container)
+            _container->close();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _summary();
+    }
+
+    size_t failures()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _failures;
+    }
+
+private:
+    // The output file of each input, or its name in the container. The
+    // inputs with the same output as a previous one are not converted.
+    std::vector<std::string> _outputNames()
+    {
+        std::vector<std::string> outputs;
+        std::map<std::string, size_t> firstInput;
+        for (size_t i = 0; i < _files.size(); ++i) {
+            const std::string stem = _stem(_files[i]);
+            outputs.push_back(_container ? stem
+                                         : _args.output + "/" + stem + _extension(_args.format));
+            const auto first = firstInput.emplace(outputs.back(), i);
+            _sameOutputAs.push_back(first.second ? _files.size() : first.first->second);
+        }
+        return outputs;
+    }
+
+    void _work()
+    {
+        for (size_t i = _next++; i < _files.size(); i = _next++) {
+            std::string error;
+            try {
+                _convert(i);
+            } catch (const std::exception& exc) {
+                error = exc.what();
+            }
+
+            const size_t bytes = error.empty() ? _fileSize(_files[i]) : 0;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (error.empty()) {
+                _bytes += bytes;
+            } else {
+                ++_failures;
+                _clearProgress();
+                std::cerr << "error: " << _files[i] << ": " << error << '\n';
+            }
+            ++_done;
+            _fileDone.notify_one();
+        }
+    }
+
+    void _convert(size_t index)
+    {
+        const std::string& input = _files[index];
+        const std::string& output = _outputs[index];
+        if (_sameOutputAs[index] < _files.size())
+            throw std::runtime_error("same output as " + _files[_sameOutputAs[index]] +
+                                     ", not converted");
+
+        morphio::mut::Morphology morphology(input);
+        _prepare(morphology);
+        if (_container) {
+            _container->add(output, morphology);
+            return;
+        }
+
+        switch (_args.format) {
+        case Format::SWC:
+            morphio::mut::writer::swc(morphology, output);
+            break;
+        case Format::ASC:
+            morphio::mut::writer::asc(morphology, output);
+            break;
+        case Format::MBIN:
+            morphio::mut::writer::binary(morphology, output);
+            break;
+        case Format::H5:
+        default:
+            morphio::mut::writer::h5(morphology, output, _args.h5Options);
+            break;
+        }
+    }
+
+    // The throughput so far, the caller holds _mutex
+    std::string _throughput() const
+    {
+        const double elapsed =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        const double filesPerSecond = elapsed > 0 ? static_cast<double>(_done) / elapsed : 0;
+        const double megaBytesPerSecond =
+            elapsed > 0 ? static_cast<double>(_bytes) / 1e6 / elapsed : 0;
+
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2) << elapsed << " s, " << std::setprecision(1)
+             << filesPerSecond << " files/s, " << megaBytesPerSecond << " MB/s";
+        return text.str();
+    }
+
+    void _progress()
+    {
+        if (_args.quiet)
+            return;
+        std::ostringstream line;
+        line << _done << '/' << _files.size() << " files in " << _throughput();
+        _clearProgress();
+        _progressWidth = line.str().size();
+        std::cerr << line.str() << std::flush;
+    }
+
+    void _clearProgress()
+    {
+        if (_progressWidth > 0)
+            std::cerr << '\r' << std::string(_progressWidth, ' ') << '\r';
+        _progressWidth = 0;
+    }
+
+    void _summary()
+    {
+        _clearProgress();
+        std::cerr << "Converted " << _done - _failures << " of " << _files.size() << " files ("
+                  << _failures << " failed) in " << _throughput() << '\n';
+    }
+
+    const Arguments& _args;
+    const std::vector<std::string>& _files;
+    std::vector<std::string> _outputs;
+    // For each input, the index of the previous input with the same output,
+    // or the number of inputs
+    std::vector<size_t> _sameOutputAs;
+    std::unique_ptr<morphio::mut::writer::ContainerWriter> _container;
+
+    std::atomic<size_t> _next{0};
+    const std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now();
+
+    // Guards the counters below and the output
+    std::mutex _mutex;
+    std::condition_variable _fileDone;
+    size_t _done = 0;
+    size_t _failures = 0;
+    size_t _bytes = 0;
+    size_t _progressWidth = 0;
+};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const Arguments args = _parse(argc, argv);
+        if (!args.warnings)
+            morphio::set_maximum_warnings(0);
+        if (!args.container && !_isDirectory(args.output))
+            throw UsageError{"the output directory does not exist: " + args.output};
+
+        const std::vector<std::string> files = _inputFiles(args.inputs);
+        Converter converter(args, files);
+        converter.run();
+        return converter.failures() > 0 ? 1 : 0;
+    } catch (const UsageError& error) {
+        std::cerr << "morphio-convert: " << error.message << "\n\n" << _usage;
+        return 2;
+    } catch (const std::exception& exc) {
+        std::cerr << "morphio-convert: " << exc.what() << '\n';
+        return 1;
+    }
+}